@@ -0,0 +1,292 @@
+/*************************************************************************
+ *
+ * This file is part of the SAMRAI distribution.  For full copyright
+ * information, see COPYRIGHT and LICENSE.
+ *
+ * Copyright:     (c) 1997-2017 Lawrence Livermore National Security, LLC
+ * Description:   Storage and communication of flux integrals on the
+ *                coarse-fine boundary of a patch level
+ *
+ ************************************************************************/
+
+#ifndef included_algs_FluxRegister
+#define included_algs_FluxRegister
+
+#include "SAMRAI/SAMRAI_config.h"
+
+#include "SAMRAI/hier/Box.h"
+#include "SAMRAI/hier/BoxId.h"
+#include "SAMRAI/hier/Connector.h"
+#include "SAMRAI/hier/IntVector.h"
+#include "SAMRAI/hier/PatchHierarchy.h"
+#include "SAMRAI/hier/PatchLevel.h"
+#include "SAMRAI/hier/PeriodicShiftCatalog.h"
+#include "SAMRAI/pdat/ArrayData.h"
+#include "SAMRAI/tbox/MessageStream.h"
+#include "SAMRAI/tbox/StartupShutdownManager.h"
+#include "SAMRAI/tbox/Timer.h"
+
+#include <memory>
+#include <vector>
+
+namespace SAMRAI {
+namespace algs {
+
+/*!
+ * @brief Class FluxRegister holds the time integrals of fluxes through
+ * the coarse-fine boundary of a patch level, at the resolution of the
+ * next coarser level, and replaces the coarse level fluxes on that
+ * boundary with them.
+ *
+ * Refluxing by coarsening flux sums defined on the whole outer boundary
+ * of every fine patch (OuterfaceData or OutersideData) stores and moves
+ * fine patch faces that are interior to the fine level, on every fine
+ * patch.  A flux register is built from the hier::CoarseFineBoundary of
+ * the fine level and keeps only the coarse faces of the coarse-fine
+ * boundary:
+ *
+ * -# initialize() finds, for each local fine patch, the coarse faces
+ *    lying on its part of the coarse-fine boundary and zeros their sums.
+ * -# accumulate() adds the flux integrals of the fine patches to the
+ *    register.  It is called after each fine step, so the register
+ *    holds the sum over the fine steps of a coarse step.
+ * -# replaceCoarseFluxes() sends the sums to the processes owning the
+ *    coarse patches touching those faces and overwrites the coarse
+ *    fluxes there.  Only processes sharing coarse-fine boundary exchange
+ *    messages.
+ *
+ * The fine fluxes of a coarse face are summed and divided by the number
+ * of fine faces covering it, which is the conservative coarsening of
+ * flux integrals on a Cartesian mesh.  The fluxes are double precision
+ * face- or side-centered data (pdat::FaceData or pdat::SideData), all of
+ * the same centering.  Fine patches must be aligned with the coarse
+ * cells, as they are for a properly nested hierarchy.  Only single
+ * block hierarchies are supported.
+ *
+ * @see hier::CoarseFineBoundary
+ * @see HyperbolicLevelIntegrator
+ */
+
+class FluxRegister
+{
+public:
+   /*!
+    * @brief Construct a flux register for the given flux data.
+    *
+    * @param[in] dim
+    * @param[in] flux_ids      Patch data indices of the fluxes.  The same
+    *                          indices are used on the fine and the coarse
+    *                          level.
+    * @param[in] flux_is_face  Whether the fluxes are pdat::FaceData (true)
+    *                          or pdat::SideData (false).
+    */
+   FluxRegister(
+      const tbox::Dimension& dim,
+      const std::vector<int>& flux_ids,
+      bool flux_is_face);
+
+   /*!
+    * @brief Destructor.
+    */
+   ~FluxRegister();
+
+   /*!
+    * @brief Set up the register for the coarse-fine boundary of the given
+    * level of the hierarchy and zero it.
+    *
+    * @param[in] hierarchy
+    * @param[in] fine_level_number
+    *
+    * @pre fine_level_number > 0
+    * @pre hierarchy.getGridGeometry()->getNumberBlocks() == 1
+    */
+   void
+   initialize(
+      const hier::PatchHierarchy& hierarchy,
+      int fine_level_number);
+
+   /*!
+    * @brief Add the fluxes of the patches of the fine level to the
+    * register.
+    *
+    * @param[in] fine_level  Must be the level given to initialize().
+    *
+    * @pre isInitialized()
+    */
+   void
+   accumulate(
+      const hier::PatchLevel& fine_level);
+
+   /*!
+    * @brief Overwrite the fluxes of the coarse level on the coarse-fine
+    * boundary with the register.
+    *
+    * This must be called by all processes of the fine level.
+    *
+    * @param[in] coarse_level  The next coarser level of the level given
+    *                          to initialize().
+    *
+    * @pre isInitialized()
+    */
+   void
+   replaceCoarseFluxes(
+      const hier::PatchLevel& coarse_level) const;
+
+   /*!
+    * @brief Release the register.
+    */
+   void
+   clear();
+
+   /*!
+    * @brief Return whether initialize() has been called since
+    * construction or the last clear().
+    */
+   bool
+   isInitialized() const
+   {
+      return d_fine_to_coarse != 0;
+   }
+
+   /*!
+    * @brief Return the number of coarse faces held locally.
+    */
+   size_t
+   getNumberOfFaces() const;
+
+private:
+   FluxRegister(
+      const FluxRegister&);             // not implemented
+   FluxRegister&
+   operator = (
+      const FluxRegister&);             // not implemented
+
+   /*
+    * Coarse faces on the coarse-fine boundary of one local fine patch,
+    * with the flux sums of each flux on them.  Face indices along d_axis
+    * are stored as cell indices, so d_faces is a one face thick box in
+    * the coarse index space.
+    */
+   struct Segment {
+      Segment(
+         const hier::BoxId& fine_box_id,
+         int axis,
+         const hier::Box& faces):
+         d_fine_box_id(fine_box_id),
+         d_axis(axis),
+         d_faces(faces)
+      {
+      }
+
+      hier::BoxId d_fine_box_id;
+      int d_axis;
+      hier::Box d_faces;
+      std::vector<std::shared_ptr<pdat::ArrayData<double> > > d_sums;
+   };
+
+   /*!
+    * @brief Put the sums of a segment on the given faces into a stream,
+    * addressed to the given coarse box.
+    *
+    * @param[in,out] stream
+    * @param[in] segment
+    * @param[in] faces  Faces of the segment to send.
+    * @param[in] coarse_box  Coarse box owning the faces, possibly a
+    *                        periodic image.  The faces are sent unshifted.
+    */
+   void
+   packFaces(
+      tbox::MessageStream& stream,
+      const Segment& segment,
+      const hier::Box& faces,
+      const hier::Box& coarse_box) const;
+
+   /*!
+    * @brief Write the faces in a stream to the fluxes of the local coarse
+    * patches.
+    */
+   void
+   unpackFaces(
+      tbox::MessageStream& stream,
+      const hier::PatchLevel& coarse_level) const;
+
+   /*!
+    * @brief Set up things for the entire class.
+    *
+    * Only called by StartupShutdownManager.
+    */
+   static void
+   initializeCallback();
+
+   /*!
+    * Free static timers.
+    *
+    * Only called by StartupShutdownManager.
+    */
+   static void
+   finalizeCallback();
+
+   const tbox::Dimension d_dim;
+
+   /*!
+    * @brief Patch data indices of the fluxes.
+    */
+   std::vector<int> d_flux_ids;
+
+   /*!
+    * @brief Depth of each flux.
+    */
+   std::vector<int> d_flux_depths;
+
+   /*!
+    * @brief Whether the fluxes are face-centered (else side-centered).
+    */
+   bool d_flux_is_face;
+
+   /*!
+    * @brief Refinement ratio between the fine and the coarse level.
+    */
+   hier::IntVector d_ratio;
+
+   /*!
+    * @brief Coarse-fine boundary segments of the local fine patches.
+    */
+   std::vector<Segment> d_segments;
+
+   /*!
+    * @brief Connectors between the fine and the coarse level, used to
+    * find the coarse patches touching the segments and the processes to
+    * exchange messages with.
+    */
+   const hier::Connector* d_fine_to_coarse;
+   const hier::Connector* d_coarse_to_fine;
+
+   /*!
+    * @brief Periodic shifts and the coarse level ratio to level zero, to
+    * unshift faces of periodic images of coarse boxes.
+    */
+   const hier::PeriodicShiftCatalog* d_shift_catalog;
+   hier::IntVector d_coarse_ratio_to_zero;
+
+   /*
+    * MPI tags for the exchange of register values.
+    */
+   static const int s_tag0 = 0;
+   static const int s_tag1 = 1;
+
+   /*!
+    * @name Timer objects for performance measurement.
+    */
+   static std::shared_ptr<tbox::Timer> t_initialize;
+   static std::shared_ptr<tbox::Timer> t_accumulate;
+   static std::shared_ptr<tbox::Timer> t_replace_coarse_fluxes;
+
+   static tbox::StartupShutdownManager::Handler
+      s_initialize_finalize_handler;
+
+};
+
+}
+}
+
+#endif
@@ -14,6 +14,7 @@
 
 #include "SAMRAI/SAMRAI_config.h"
 
+#include "SAMRAI/algs/FluxRegister.h"
 #include "SAMRAI/algs/HyperbolicPatchStrategy.h"
 #include "SAMRAI/algs/HyperbolicPatchStrategy.h"
 #include "SAMRAI/algs/TimeRefinementLevelStrategy.h"
@@ -31,6 +32,7 @@
 #include "SAMRAI/tbox/Timer.h"
 
 #include <list>
+#include <utility>
 #include <vector>
 #include <memory>
 
@@ -102,6 +104,34 @@ namespace algs {
  *       indicates whether ghost data must be filled before timestep is
  *       computed on each patch (possible communication optimization)
  *
+ *    - \b    use_threaded_patch_loops
+ *       indicates whether the per-patch numerical routines called in
+ *       advanceLevel() and getLevelDt() are dispatched across OpenMP
+ *       threads.  Only honored when the patch strategy declares them
+ *       thread-safe (see
+ *       HyperbolicPatchStrategy::patchRoutinesAreThreadSafe()).
+ *
+ *    - \b    use_flux_registers
+ *       indicates whether flux integrals are kept only on the coarse-fine
+ *       boundary of each level, in a FluxRegister, instead of on the
+ *       outer faces of every patch.  Only the processes sharing
+ *       coarse-fine boundary then exchange data at synchronization.
+ *       Requires a Cartesian, single block grid geometry.
+ *
+ *    - \b    use_patch_group_time_stepping
+ *       indicates whether the patches of a level are split into groups
+ *       by their stable time increment, each group advancing with the
+ *       level increment divided by a power of two.  Ghost data at group
+ *       interfaces is time interpolated, and fluxes on group interfaces
+ *       are corrected so the level advance stays conservative.  The
+ *       level increment returned by advanceLevel() is then chosen to
+ *       minimize the number of cell updates per unit time.  Requires a
+ *       time interpolation operator for every TIME_DEP variable.
+ *
+ *    - \b    max_patch_groups
+ *       maximum number of patch groups; the patches of group k take
+ *       2^k steps per level step.
+ *
  * Note that when continuing from restart, the input parameters in the input
  * database override all values read in from the restart database.
  *
@@ -147,6 +177,38 @@ namespace algs {
  *     <td>opt</td>
  *     <td>Parameter read from restart db may be overridden by input db</td>
  *   </tr>
+ *   <tr>
+ *     <td>use_threaded_patch_loops</td>
+ *     <td>bool</td>
+ *     <td>FALSE</td>
+ *     <td>TRUE, FALSE</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>use_flux_registers</td>
+ *     <td>bool</td>
+ *     <td>FALSE</td>
+ *     <td>TRUE, FALSE</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>use_patch_group_time_stepping</td>
+ *     <td>bool</td>
+ *     <td>FALSE</td>
+ *     <td>TRUE, FALSE</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>max_patch_groups</td>
+ *     <td>int</td>
+ *     <td>3</td>
+ *     <td>1-16</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
  * </table>
  *
  * A sample input file entry might look like:
@@ -519,6 +581,44 @@ public:
    using mesh::StandardTagAndInitStrategy::initializeLevelData;
 #endif
 
+   /**
+    * Split-phase version of initializeLevelData().  The schedule that
+    * fills the new level from the old level and coarser levels is
+    * started here but not completed, so the gridding algorithm may do
+    * other regrid work while the data is in transit.  The data
+    * initialization is completed by finalizeLevelDataInitialization().
+    *
+    * Only one level may have a pending initialization at a time.
+    *
+    * @pre hierarchy
+    * @pre (level_number >= 0) &&
+    *      (level_number <= hierarchy->getFinestLevelNumber())
+    * @pre !old_level || (level_number == old_level->getLevelNumber())
+    * @pre hierarchy->getPatchLevel(level_number)
+    */
+   void
+   beginLevelDataInitialization(
+      const std::shared_ptr<hier::PatchHierarchy>& hierarchy,
+      const int level_number,
+      const double init_data_time,
+      const bool can_be_refined,
+      const bool initial_time,
+      const std::shared_ptr<hier::PatchLevel>& old_level =
+         std::shared_ptr<hier::PatchLevel>(),
+      const bool allocate_data = true);
+
+   /**
+    * Complete the data initialization started by
+    * beginLevelDataInitialization().
+    *
+    * @pre hierarchy
+    * @pre hierarchy->getPatchLevel(level_number)
+    */
+   void
+   finalizeLevelDataInitialization(
+      const std::shared_ptr<hier::PatchHierarchy>& hierarchy,
+      const int level_number);
+
    /**
     * Reset cached communication schedules after the hierarchy has changed
     * (due to regidding, for example) and the data has been initialized on
@@ -731,6 +831,17 @@ public:
       return d_plot_context;
    }
 
+   /**
+    * Return the number of advances of local patches by the numerical
+    * routines of the patch strategy so far, over all levels.  A patch
+    * of patch group k is counted 2^k times per level step.
+    */
+   double
+   getNumberOfPatchUpdates() const
+   {
+      return d_num_patch_updates;
+   }
+
    /**
     * Return true if this class has been constructed to use refined
     * timestepping and false if it has been constructed to use
@@ -742,6 +853,32 @@ public:
       return d_use_time_refinement;
    }
 
+   /**
+    * Set whether the per-patch numerical routines of the patch strategy
+    * are dispatched across OpenMP threads.  Patches are handed out
+    * largest first with dynamic scheduling, so that threads finish
+    * together when patch sizes vary.  The setting has no effect unless
+    * the patch strategy declares its routines thread-safe, and the loops
+    * run serially if SAMRAI is built without OpenMP.
+    */
+   void
+   setThreadedPatchLoops(
+      bool flag)
+   {
+      d_use_threaded_patch_loops = flag;
+   }
+
+   /**
+    * Return true if the per-patch numerical routines are dispatched
+    * across threads.
+    */
+   bool
+   usingThreadedPatchLoops() const
+   {
+      return d_use_threaded_patch_loops &&
+             d_patch_strategy->patchRoutinesAreThreadSafe();
+   }
+
    /*
     * Write out statistics recorded on numbers of cells and patches generated.
     */
@@ -827,6 +964,19 @@ protected:
       const bool first_step,
       const bool last_step);
 
+   /*
+    * Return whether the flux integrals of the given level are held in
+    * a flux register for the current coarse step.
+    */
+   bool
+   usingFluxRegister(
+      const int level_number) const
+   {
+      return level_number > 0 &&
+             level_number < static_cast<int>(d_flux_registers.size()) &&
+             d_flux_registers[level_number];
+   }
+
    /*
     * Copy time-dependent data from source space to destination space.
     */
@@ -912,6 +1062,113 @@ private:
       const hier::PatchLevel& patch_level,
       double current_time);
 
+   /*
+    * Allocate data on a level being initialized and create the schedule
+    * that fills it.  Returns a null schedule if the level needs no fill.
+    */
+   std::shared_ptr<xfer::RefineSchedule>
+   prepareLevelDataInitialization(
+      const std::shared_ptr<hier::PatchHierarchy>& hierarchy,
+      const int level_number,
+      const double init_data_time,
+      const std::shared_ptr<hier::PatchLevel>& old_level,
+      const bool allocate_data);
+
+   /*
+    * Operations on a level being initialized that follow filling it:
+    * time level bookkeeping and initialization of patch interiors.
+    */
+   void
+   completeLevelDataInitialization(
+      const std::shared_ptr<hier::PatchLevel>& level,
+      const double init_data_time,
+      const bool can_be_refined,
+      const bool initial_time);
+
+   /*
+    * Threaded versions of the patch loops of advanceLevel() and
+    * getLevelDt().  Temporary scratch data is allocated on the whole
+    * level before the loop instead of patch by patch, so the threads
+    * only call the patch strategy.  The data context of the patch
+    * strategy must be set by the caller.
+    */
+   void
+   advancePatchesThreaded(
+      hier::PatchLevel& level,
+      const double current_time,
+      const double dt);
+
+   double
+   computeStableDtThreaded(
+      hier::PatchLevel& level,
+      const bool initial_time,
+      const double dt_time);
+
+   /*
+    * Collect the local patches of a level, largest first.
+    */
+   void
+   getPatchesLargestFirst(
+      const hier::PatchLevel& level,
+      std::vector<hier::Patch *>& patches) const;
+
+   /*
+    * Patch loop of advanceLevel() for patch group time stepping.  It
+    * leaves the advanced solution in the NEW context, and the flux
+    * integrals over the level step in the flux data.  The data context
+    * of the patch strategy must be set to SCRATCH by the caller.
+    */
+   void
+   advancePatchGroups(
+      const std::shared_ptr<hier::PatchHierarchy>& hierarchy,
+      const std::shared_ptr<hier::PatchLevel>& level,
+      const double current_time,
+      const double new_time);
+
+   /*
+    * Advance group k from the given tick, and recursively the groups
+    * of smaller increments over the same interval.  Group k steps over
+    * num_ticks ticks of the level step.
+    */
+   void
+   advancePatchGroup(
+      hier::PatchLevel& level,
+      const int k,
+      const int first_tick,
+      const int num_ticks);
+
+   /*
+    * Replace the flux integrals of the patches on faces shared with
+    * a patch of a group with smaller increments by the integrals of
+    * that patch.  Return, for each local patch, whether any flux
+    * integral was replaced.
+    */
+   void
+   correctPatchGroupFluxes(
+      const std::shared_ptr<hier::PatchLevel>& level,
+      std::vector<bool>& corrected);
+
+   /*
+    * Given the stable increment and cell count of the local patches and
+    * the global minimum increment (CFL factor applied), return the
+    * level increment, a power of two multiple of the minimum, that
+    * minimizes the number of cell updates per unit time.
+    */
+   double
+   selectPatchGroupLevelDt(
+      const tbox::SAMRAI_MPI& mpi,
+      const std::vector<std::pair<double, size_t> >& patch_dt,
+      const double min_dt) const;
+
+   /*
+    * Return the group of a patch whose stable increment, CFL factor
+    * applied, is patch_dt, for a level increment dt.
+    */
+   int
+   getPatchGroup(
+      const double patch_dt,
+      const double dt) const;
+
    /*
     * The patch strategy supplies the application-specific operations
     * needed to treat data on patches in the AMR hierarchy.
@@ -1038,6 +1295,17 @@ private:
     */
    std::shared_ptr<xfer::RefineAlgorithm> d_fill_new_level;
 
+   /*
+    * Schedule and arguments of a level initialization started by
+    * beginLevelDataInitialization() and not yet finalized.  The level
+    * number is -1 when there is no pending initialization.
+    */
+   std::shared_ptr<xfer::RefineSchedule> d_pending_init_sched;
+   int d_pending_init_ln;
+   double d_pending_init_time;
+   bool d_pending_init_can_be_refined;
+   bool d_pending_init_initial_time;
+
    /*
     * Number of levels of time-dependent data that must be maintained
     * on each patch level.  This value is used to coordinate the needs
@@ -1122,6 +1390,62 @@ private:
     */
    bool d_barrier_advance_level_sections;
 
+   /*
+    * Whether per-patch numerical routines are dispatched across threads.
+    */
+   bool d_use_threaded_patch_loops;
+
+   /*
+    * Whether flux integrals are accumulated in flux registers, and the
+    * register of each level, holding the coarse-fine boundary fluxes of
+    * the current coarse step.
+    */
+   bool d_use_flux_registers;
+   std::vector<std::shared_ptr<FluxRegister> > d_flux_registers;
+
+   /*
+    * Patch group time stepping.  The PATCH_GROUP context holds the
+    * solution at the start of the last step of each patch, the flux
+    * integrals of each patch over the level step, and the data
+    * exchanged to correct fluxes on group interfaces.  The fill
+    * algorithm time interpolates ghost data on the level between the
+    * PATCH_GROUP and NEW solution of the neighboring patches, and on
+    * the next coarser level between its PATCH_GROUP solution, a copy of
+    * its CURRENT solution, and its NEW solution.
+    */
+   bool d_use_patch_group_time_stepping;
+   int d_max_patch_groups;
+   std::shared_ptr<hier::VariableContext> d_patch_group;
+   hier::ComponentSelector d_patch_group_data;
+   std::vector<int> d_patch_group_old_ids;
+   hier::ComponentSelector d_patch_group_old_data;
+   std::vector<int> d_patch_group_fluxsum_ids;
+   std::vector<int> d_patch_group_neighbor_flux_ids;
+   int d_patch_group_id;
+   std::shared_ptr<xfer::RefineAlgorithm> d_patch_group_fill;
+   std::shared_ptr<xfer::RefineAlgorithm> d_patch_group_exchange;
+   std::vector<std::shared_ptr<xfer::RefineSchedule> >
+   d_patch_group_fill_sched;
+   std::vector<std::shared_ptr<xfer::RefineSchedule> >
+   d_patch_group_exchange_sched;
+
+   /*
+    * State of the patch group advance in progress: the patches and
+    * global size of each group, the number of groups and of ticks in
+    * the level step, and the start and end of the level step.
+    */
+   std::vector<std::vector<hier::Patch *> > d_patch_groups;
+   std::vector<int> d_patch_group_sizes;
+   int d_num_patch_groups;
+   int d_patch_group_ticks;
+   double d_patch_group_time;
+   double d_patch_group_new_time;
+
+   /*
+    * Number of local patch advances, counted over all levels.
+    */
+   double d_num_patch_updates;
+
    /*
     * Timers interspersed throughout the class.
     */
@@ -1151,6 +1475,7 @@ private:
    static std::shared_ptr<tbox::Timer> t_postprocess_flux_data;
    static std::shared_ptr<tbox::Timer> t_advance_level_sync;
    static std::shared_ptr<tbox::Timer> t_advance_level_compute_dt;
+   static std::shared_ptr<tbox::Timer> t_advance_patch_groups;
    static std::shared_ptr<tbox::Timer> t_copy_time_dependent_data;
    static std::shared_ptr<tbox::Timer> t_std_level_sync;
    static std::shared_ptr<tbox::Timer> t_sync_new_levels;
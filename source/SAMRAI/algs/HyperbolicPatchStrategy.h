@@ -136,6 +136,24 @@ public:
       const bool initial_time,
       const double dt_time) = 0;
 
+   /**
+    * Return true if computeStableDtOnPatch(), computeFluxesOnPatch() and
+    * conservativeDifferenceOnPatch() may be called concurrently on
+    * different patches of a level.  They must then write only to data on
+    * the patch they are given and must not modify shared members of the
+    * strategy.  When this returns true, the HyperbolicLevelIntegrator may
+    * dispatch these routines across threads (see its input parameter
+    * use_threaded_patch_loops).
+    *
+    * Note that this function is not pure virtual.  The default
+    * implementation returns false.
+    */
+   virtual bool
+   patchRoutinesAreThreadSafe() const
+   {
+      return false;
+   }
+
    /**
     * Compute TIME INTEGRALS of fluxes to be used in conservative difference
     * for patch integration.  That is, it is assumed that this numerical
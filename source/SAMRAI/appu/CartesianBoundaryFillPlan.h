@@ -0,0 +1,327 @@
+/*************************************************************************
+ *
+ * This file is part of the SAMRAI distribution.  For full copyright
+ * information, see COPYRIGHT and LICENSE.
+ *
+ * Copyright:     (c) 1997-2017 Lawrence Livermore National Security, LLC
+ * Description:   Precomputed fill of Cartesian physical boundary data
+ *
+ ************************************************************************/
+
+#ifndef included_appu_CartesianBoundaryFillPlan
+#define included_appu_CartesianBoundaryFillPlan
+
+#include "SAMRAI/SAMRAI_config.h"
+
+#include "SAMRAI/hier/Box.h"
+#include "SAMRAI/hier/IntVector.h"
+#include "SAMRAI/hier/Patch.h"
+#include "SAMRAI/hier/PatchGeometry.h"
+#include "SAMRAI/pdat/CellData.h"
+
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace SAMRAI {
+namespace appu {
+
+/*!
+ * @brief Class CartesianBoundaryFillPlan fills the physical boundary
+ * ghost cells of cell-centered double data on one patch with the
+ * boundary conditions of CartesianBoundaryDefines.h, in any dimension.
+ *
+ * The fill routines of CartesianBoundaryUtilities2 and
+ * CartesianBoundaryUtilities3 find the fill boxes of a patch, decode the
+ * boundary conditions and call a FORTRAN routine for every boundary box
+ * of every variable, each time physical boundaries are filled.  A plan
+ * does that work once per patch, ghost width and set of boundary
+ * conditions, and keeps for each boundary box its fill box, the
+ * direction and interior cell index the condition pivots on, the
+ * condition and the location of its boundary values.  fill() then runs
+ * a single loop over the boundary boxes, filling all given variables
+ * box by box, without allocating memory.  The innermost loop runs over
+ * contiguous cells in the first direction so that the compiler can
+ * vectorize it.
+ *
+ * The results are identical to those of the fill routines of
+ * CartesianBoundaryUtilities2 and CartesianBoundaryUtilities3:
+ *
+ * - FLOW copies the interior cell next to the boundary.
+ * - REFLECT copies it and negates the component of the data along the
+ *   boundary normal.
+ * - DIRICHLET sets the boundary value.
+ * - NEUMANN extrapolates from the interior cell with the boundary value
+ *   as the normal derivative.
+ *
+ * Boundary boxes of codimension one (edges in 2d, faces in 3d, nodes in
+ * 1d) take the plain conditions; the others take the X, Y or Z variants,
+ * which choose the direction the condition applies in.  Boundary values
+ * are given per codimension one boundary location, as for the fill
+ * routines of CartesianBoundaryUtilities2 and CartesianBoundaryUtilities3.
+ * Boxes of lower codimension are filled first, since boxes of higher
+ * codimension read the ghost cells they fill.
+ *
+ * Plans are usually obtained from a CartesianBoundaryFillPlan::Cache,
+ * which keeps them for the lifetime of the patch geometry they were
+ * built for.
+ *
+ * A plan is not invoked by xfer::RefineSchedule::fillPhysicalBoundaries.
+ * The schedule leaves physical boundary conditions to the
+ * xfer::RefinePatchStrategy of the application, which alone knows the
+ * conditions and boundary values of each variable, and the xfer package
+ * does not depend on appu.  Applications use a plan from their
+ * implementation of setPhysicalBoundaryConditions() in place of the fill
+ * routines of CartesianBoundaryUtilities2 and CartesianBoundaryUtilities3;
+ * the boundary test compares the two fills cell by cell.
+ *
+ * @see CartesianBoundaryUtilities2
+ * @see CartesianBoundaryUtilities3
+ */
+
+class CartesianBoundaryFillPlan
+{
+public:
+   /*!
+    * @brief Class Cache holds the fill plans of the patches of a
+    * hierarchy.
+    *
+    * A plan is built the first time it is requested for a patch geometry,
+    * ghost width and set of boundary conditions, and is returned for
+    * later requests with the same arguments.  Plans of patch geometries
+    * that no longer exist (e.g., after a regrid) are released as new
+    * ones are built.  A cache must not be used by several threads at
+    * once.
+    */
+   class Cache
+   {
+   public:
+      /*!
+       * @brief Construct an empty cache.
+       */
+      Cache();
+
+      /*!
+       * @brief Destructor.
+       */
+      ~Cache();
+
+      /*!
+       * @brief Return the plan of the given patch for the given ghost
+       * width and boundary conditions, building it if needed.
+       *
+       * See the CartesianBoundaryFillPlan constructor for the arguments.
+       */
+      const CartesianBoundaryFillPlan&
+      getPlan(
+         const hier::Patch& patch,
+         const hier::IntVector& ghost_width_to_fill,
+         const std::vector<int>& codim1_conds,
+         const std::vector<int>& codim2_conds = std::vector<int>(),
+         const std::vector<int>& codim3_conds = std::vector<int>());
+
+      /*!
+       * @brief Release all plans.
+       */
+      void
+      clear();
+
+      /*!
+       * @brief Return the number of plans held.
+       */
+      size_t
+      getNumberOfPlans() const;
+
+   private:
+      Cache(
+         const Cache&);                 // not implemented
+      Cache&
+      operator = (
+         const Cache&);                 // not implemented
+
+      /*
+       * Plans of one patch geometry.  The geometry is held weakly so that
+       * an entry whose geometry was deleted, and whose address may have
+       * been reused, is recognized.
+       */
+      struct Entry {
+         std::weak_ptr<hier::PatchGeometry> d_geometry;
+         std::vector<std::shared_ptr<CartesianBoundaryFillPlan> > d_plans;
+      };
+
+      /*!
+       * @brief Remove the entries of deleted patch geometries.
+       */
+      void
+      removeExpiredEntries();
+
+      std::map<const hier::PatchGeometry *, Entry> d_entries;
+
+      /*!
+       * @brief Number of entries added since expired entries were last
+       * removed.
+       */
+      size_t d_num_added;
+   };
+
+   /*!
+    * @brief Build the plan for the given patch.
+    *
+    * Condition arrays are indexed by the location index of the boundary
+    * boxes of the corresponding codimension, as for the fill routines of
+    * CartesianBoundaryUtilities2 and CartesianBoundaryUtilities3.  Arrays
+    * for codimensions greater than the dimension are ignored.
+    *
+    * @param[in] patch  Patch with a geom::CartesianPatchGeometry.
+    * @param[in] ghost_width_to_fill  Width of the ghost region to fill.
+    * @param[in] codim1_conds  Conditions for node boundaries in 1d, edge
+    *                          boundaries in 2d or face boundaries in 3d.
+    * @param[in] codim2_conds  Conditions for node boundaries in 2d or edge
+    *                          boundaries in 3d.
+    * @param[in] codim3_conds  Conditions for node boundaries in 3d.
+    *
+    * @pre patch.getDim() == ghost_width_to_fill.getDim()
+    */
+   CartesianBoundaryFillPlan(
+      const hier::Patch& patch,
+      const hier::IntVector& ghost_width_to_fill,
+      const std::vector<int>& codim1_conds,
+      const std::vector<int>& codim2_conds = std::vector<int>(),
+      const std::vector<int>& codim3_conds = std::vector<int>());
+
+   /*!
+    * @brief Destructor.
+    */
+   ~CartesianBoundaryFillPlan();
+
+   /*!
+    * @brief Return whether the plan was built with the given ghost width
+    * and conditions.
+    */
+   bool
+   matches(
+      const hier::IntVector& ghost_width_to_fill,
+      const std::vector<int>& codim1_conds,
+      const std::vector<int>& codim2_conds,
+      const std::vector<int>& codim3_conds) const;
+
+   /*!
+    * @brief Fill the physical boundary ghost cells of one variable.
+    *
+    * Only ghost cells within the ghost cell width of the data are filled.
+    *
+    * @param[in,out] data  Data on the patch the plan was built for.
+    * @param[in] bdry_values  Boundary values for DIRICHLET and NEUMANN
+    *                         conditions, with the value of component k at
+    *                         codimension one location i at
+    *                         i * data.getDepth() + k.
+    *
+    * @pre bdry_values.size() == 2 * dim * data.getDepth()
+    */
+   void
+   fill(
+      pdat::CellData<double>& data,
+      const std::vector<double>& bdry_values) const;
+
+   /*!
+    * @brief Fill the physical boundary ghost cells of several variables
+    * in one pass over the boundary boxes.
+    *
+    * @param[in,out] data  Data on the patch the plan was built for.
+    * @param[in] bdry_values  Boundary values of each variable, as for the
+    *                         single variable fill().
+    *
+    * @pre data.size() == bdry_values.size()
+    */
+   void
+   fill(
+      const std::vector<pdat::CellData<double> *>& data,
+      const std::vector<const std::vector<double> *>& bdry_values) const;
+
+   /*!
+    * @brief Return the number of boundary boxes with cells to fill.
+    */
+   size_t
+   getNumberOfFillBoxes() const
+   {
+      return d_fill_boxes.size();
+   }
+
+private:
+   CartesianBoundaryFillPlan(
+      const CartesianBoundaryFillPlan&);        // not implemented
+   CartesianBoundaryFillPlan&
+   operator = (
+      const CartesianBoundaryFillPlan&);        // not implemented
+
+   /*
+    * Kind of fill, independent of the direction it applies in.
+    */
+   enum FillType {
+      FILL_FLOW = 0,
+      FILL_REFLECT = 1,
+      FILL_DIRICHLET = 2,
+      FILL_NEUMANN = 3
+   };
+
+   /*
+    * Precomputed fill of one boundary box.
+    */
+   struct FillBox {
+      FillBox(
+         const hier::Box& box,
+         FillType type,
+         tbox::Dimension::dir_t axis,
+         int pivot,
+         double dirsign,
+         int value_loc):
+         d_box(box),
+         d_type(type),
+         d_axis(axis),
+         d_pivot(pivot),
+         d_dirsign(dirsign),
+         d_value_loc(value_loc)
+      {
+      }
+
+      hier::Box d_box;
+      FillType d_type;
+      tbox::Dimension::dir_t d_axis;
+      int d_pivot;
+      double d_dirsign;
+      int d_value_loc;
+   };
+
+   /*!
+    * @brief Fill one box of one variable.
+    */
+   void
+   fillBox(
+      const FillBox& fill_box,
+      pdat::CellData<double>& data,
+      const std::vector<double>& bdry_values) const;
+
+   const tbox::Dimension d_dim;
+
+   /*!
+    * @brief Ghost width and conditions the plan was built with.
+    */
+   hier::IntVector d_ghost_width_to_fill;
+   std::vector<int> d_conds[SAMRAI::MAX_DIM_VAL];
+
+   /*!
+    * @brief Mesh spacing of the patch.
+    */
+   double d_dx[SAMRAI::MAX_DIM_VAL];
+
+   /*!
+    * @brief Fill boxes, by increasing codimension.
+    */
+   std::vector<FillBox> d_fill_boxes;
+
+};
+
+}
+}
+
+#endif
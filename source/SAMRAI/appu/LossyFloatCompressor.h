@@ -0,0 +1,176 @@
+/*************************************************************************
+ *
+ * This file is part of the SAMRAI distribution.  For full copyright
+ * information, see COPYRIGHT and LICENSE.
+ *
+ * Copyright:     (c) 1997-2017 Lawrence Livermore National Security, LLC
+ * Description:   Error-bounded lossy compression of float arrays
+ *
+ ************************************************************************/
+
+#ifndef included_appu_LossyFloatCompressor
+#define included_appu_LossyFloatCompressor
+
+#include "SAMRAI/SAMRAI_config.h"
+
+#ifdef HAVE_HDF5
+#include "hdf5.h"
+#endif
+
+#include <vector>
+
+namespace SAMRAI {
+namespace appu {
+
+/*!
+ * @brief Class LossyFloatCompressor compresses arrays of floats such
+ * that no decompressed value differs from the original by more than a
+ * given tolerance.
+ *
+ * The compression follows the scheme of block transform coders such as
+ * ZFP:
+ *
+ * -# Each value is quantized to the nearest multiple of a step of twice
+ *    the tolerance, less a margin for the rounding of the decompressed
+ *    values to float.
+ * -# The quantized values are split into blocks of four consecutive
+ *    values, and a reversible integer transform (two levels of the
+ *    S-transform) turns each block into its mean and three differences.
+ *    The mean is replaced by its difference with the mean of the
+ *    previous block.
+ * -# The four coefficients of each block are written with the number of
+ *    bits needed by the largest of them.
+ *
+ * Smooth data gives small coefficients, so blocks take few bits.  The
+ * transform is exact on the quantized values, so the only errors are
+ * those of the quantization and of the rounding of the decompressed
+ * values to float.  The quantization step is computed in double and
+ * reduced by a bound on the rounding error, so that no decompressed
+ * value differs from the original float by more than the tolerance.
+ * Data whose tolerance is below that bound (about 2^-23 times the
+ * largest magnitude), whose quantized values would not fit in 52 bits,
+ * or containing infinities or NaNs, is stored uncompressed, as is data
+ * that does not get smaller; constant data is stored as a single value.
+ *
+ * The tolerance is absolute or relative to the range (max - min) of the
+ * compressed array.  A tolerance of zero stores the data uncompressed.
+ *
+ * When SAMRAI is built with HDF5, the compressor is also available as
+ * an HDF5 filter (see registerHDF5Filter()), so that datasets written
+ * with it are decompressed transparently when read by a process that has
+ * registered the filter.  appu::VisItDataWriter uses it for plot
+ * quantities registered with a compression tolerance.  Other readers of
+ * such datasets (VisIt, h5py, h5dump) load the filter from the HDF5
+ * filter plugin built in tools/h5plugin and installed in lib/plugin,
+ * which they find through the HDF5_PLUGIN_PATH environment variable.
+ */
+
+class LossyFloatCompressor
+{
+public:
+   /*!
+    * @brief Compress an array.
+    *
+    * @param[out] compressed  The compressed stream; previous contents
+    *                         are replaced.
+    * @param[in] data
+    * @param[in] num_values
+    * @param[in] tolerance  Largest allowed error, absolute or relative.
+    * @param[in] relative  Whether the tolerance is relative to the range
+    *                      of the data.
+    *
+    * @pre num_values == 0 || data != 0
+    * @pre tolerance >= 0.0
+    */
+   static void
+   compress(
+      std::vector<unsigned char>& compressed,
+      const float* data,
+      size_t num_values,
+      double tolerance,
+      bool relative);
+
+   /*!
+    * @brief Decompress a stream written by compress().
+    *
+    * @param[out] data  The decompressed values; previous contents are
+    *                   replaced.
+    * @param[in] compressed
+    * @param[in] num_bytes
+    *
+    * @return Whether the stream was valid.
+    */
+   static bool
+   decompress(
+      std::vector<float>& data,
+      const unsigned char* compressed,
+      size_t num_bytes);
+
+#ifdef HAVE_HDF5
+   /*!
+    * @brief Identifier of the HDF5 filter.
+    *
+    * It is in the range HDF5 sets aside for unregistered filters (256 to
+    * 511), which is not coordinated with The HDF Group.  Processes that
+    * neither call registerHDF5Filter() nor load the HDF5 filter plugin
+    * cannot read the filtered datasets.
+    */
+   static const H5Z_filter_t HDF5_FILTER_ID = 300;
+
+   /*!
+    * @brief Return the class of the HDF5 filter, which
+    * registerHDF5Filter() registers and the HDF5 filter plugin returns
+    * to the HDF5 library.
+    */
+   static const H5Z_class2_t *
+   getHDF5FilterClass();
+
+   /*!
+    * @brief Register the HDF5 filter with the HDF5 library, if it is not
+    * registered yet.
+    */
+   static void
+   registerHDF5Filter();
+
+   /*!
+    * @brief Return the parameters (client data values) of the HDF5 filter
+    * for the given tolerance.
+    *
+    * @pre tolerance >= 0.0
+    */
+   static std::vector<unsigned int>
+   getHDF5FilterParameters(
+      double tolerance,
+      bool relative);
+#endif
+
+private:
+   // Not implemented: all members are static.
+   LossyFloatCompressor();
+
+#ifdef HAVE_HDF5
+   /*
+    * Callbacks of the HDF5 filter.
+    */
+   static herr_t
+   setLocalHDF5Filter(
+      hid_t dcpl_id,
+      hid_t type_id,
+      hid_t space_id);
+
+   static size_t
+   applyHDF5Filter(
+      unsigned int flags,
+      size_t cd_nelmts,
+      const unsigned int cd_values[],
+      size_t nbytes,
+      size_t* buf_size,
+      void** buf);
+#endif
+
+};
+
+}
+}
+
+#endif
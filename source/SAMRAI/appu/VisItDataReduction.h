@@ -0,0 +1,304 @@
+/*************************************************************************
+ *
+ * This file is part of the SAMRAI distribution.  For full copyright
+ * information, see COPYRIGHT and LICENSE.
+ *
+ * Copyright:     (c) 1997-2017 Lawrence Livermore National Security, LLC
+ * Description:   In-situ reduction of the data written by VisItDataWriter
+ *
+ ************************************************************************/
+
+#ifndef included_appu_VisItDataReduction
+#define included_appu_VisItDataReduction
+
+#include "SAMRAI/SAMRAI_config.h"
+
+#include "SAMRAI/hier/BaseGridGeometry.h"
+#include "SAMRAI/hier/Box.h"
+#include "SAMRAI/hier/ComponentSelector.h"
+#include "SAMRAI/hier/IntVector.h"
+#include "SAMRAI/hier/Patch.h"
+#include "SAMRAI/hier/PatchHierarchy.h"
+#include "SAMRAI/tbox/Database.h"
+#include "SAMRAI/tbox/Dimension.h"
+#include "SAMRAI/tbox/StartupShutdownManager.h"
+#include "SAMRAI/tbox/Timer.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace SAMRAI {
+namespace appu {
+
+/*!
+ * @brief Class VisItDataReduction reduces a patch hierarchy to the part
+ * of it that is to be plotted, before VisItDataWriter writes it.
+ *
+ * The reduction builds a temporary hierarchy whose patches are pieces of
+ * the patches of the simulation hierarchy, and fills them with the data
+ * of the simulation patches.  Each local patch is reduced on its own, so
+ * no communication other than the numbering of the reduced patches is
+ * needed.  The reductions, all optional, are:
+ *
+ * - Writing only the levels up to a given level.
+ * - Coarsening every written level by a given ratio.  The data is
+ *   coarsened with the coarsening operator of the given name registered
+ *   with the grid geometry (see hier::TransferOperatorRegistry),
+ *   conservative averaging by default.  Patch boxes must be multiples of
+ *   the ratio; for levels above level zero, a ratio dividing the ratio to
+ *   the coarser level ensures this.
+ * - Writing only the cells within a region, given by the physical
+ *   coordinates of its corners.
+ * - Writing only axis-aligned slices, one cell thick, given by their
+ *   normal direction and physical coordinate.  A cell on several slices
+ *   (e.g., on the line where slices of different directions cross) is
+ *   written once, by the first slice listed that contains it.
+ *
+ * Region and slices require a single block geom::CartesianGridGeometry.
+ * The reduced patches hold only the selected components that are
+ * allocated on the simulation patches; VisItDataWriter selects those of
+ * its plot items and those its derived, material and species data
+ * writers read.  When coarsening, components whose variable has no
+ * coarsening operator of the given name are left out.
+ * Ghost cells of the reduced patches are not filled, so a data writer
+ * writing ghost cells cannot use a reduction.
+ *
+ * Input parameters (all optional):
+ *
+ * - \b max_level
+ *      Finest level to write.  Default: all levels.
+ * - \b coarsen_ratio
+ *      Integer array of the coarsening ratio in each direction.
+ *      Default: 1 in each direction.
+ * - \b coarsen_operator
+ *      Name of the coarsening operator.  Default: "CONSERVATIVE_COARSEN".
+ * - \b region_lower, \b region_upper
+ *      Double arrays of the lower and upper corners of the region to
+ *      write.  Default: the whole domain.
+ * - \b slice_axes, \b slice_coordinates
+ *      Integer and double arrays of the normal direction and coordinate
+ *      of each slice.  Default: no slices.
+ *
+ * Example:
+ * @code
+ *    VisItDataReduction {
+ *       max_level = 1
+ *       coarsen_ratio = 2, 2, 2
+ *       region_lower = 0.0, 0.0, 0.0
+ *       region_upper = 10.0, 5.0, 5.0
+ *       slice_axes = 2
+ *       slice_coordinates = 2.5
+ *    }
+ * @endcode
+ *
+ * @see VisItDataWriter::setDataReduction()
+ */
+
+class VisItDataReduction
+{
+public:
+   /*!
+    * @brief Constructor.
+    *
+    * @param[in] dim
+    * @param[in] object_name
+    * @param[in] input_db  Input parameters; a null pointer gives no
+    *                      reduction.
+    *
+    * @pre !object_name.empty()
+    */
+   VisItDataReduction(
+      const tbox::Dimension& dim,
+      const std::string& object_name,
+      const std::shared_ptr<tbox::Database>& input_db =
+         std::shared_ptr<tbox::Database>());
+
+   /*!
+    * @brief Destructor.
+    */
+   ~VisItDataReduction();
+
+   /*!
+    * @brief Build the reduced copy of a hierarchy and fill its data.
+    *
+    * This must be called by all processes of the hierarchy.  The reduced
+    * hierarchy has globally sequentialized patch indices.
+    *
+    * @param[in] hierarchy
+    * @param[in] components  Patch data components to copy to the reduced
+    *                        patches; components not allocated on a patch
+    *                        are skipped.
+    *
+    * @pre hierarchy
+    * @pre hierarchy->getDim() == getDim()
+    */
+   std::shared_ptr<hier::PatchHierarchy>
+   reduceHierarchy(
+      const std::shared_ptr<hier::PatchHierarchy>& hierarchy,
+      const hier::ComponentSelector& components);
+
+   /*!
+    * @brief Return the finest level written, or -1 for all levels.
+    */
+   int
+   getMaxLevel() const
+   {
+      return d_max_level;
+   }
+
+   /*!
+    * @brief Return the coarsening ratio of the written levels.
+    */
+   const hier::IntVector&
+   getCoarsenRatio() const
+   {
+      return d_coarsen_ratio;
+   }
+
+   /*!
+    * @brief Return the object name.
+    */
+   const std::string&
+   getObjectName() const
+   {
+      return d_object_name;
+   }
+
+   /*!
+    * @brief Return the dimension.
+    */
+   const tbox::Dimension&
+   getDim() const
+   {
+      return d_dim;
+   }
+
+private:
+   VisItDataReduction(
+      const VisItDataReduction&);               // not implemented
+   VisItDataReduction&
+   operator = (
+      const VisItDataReduction&);               // not implemented
+
+   /*!
+    * @brief Read the input parameters.
+    */
+   void
+   getFromInput(
+      const std::shared_ptr<tbox::Database>& input_db);
+
+   /*!
+    * @brief Return the grid geometry of the reduced hierarchy.
+    */
+   std::shared_ptr<hier::BaseGridGeometry>
+   getReducedGridGeometry(
+      const hier::PatchHierarchy& hierarchy);
+
+   /*!
+    * @brief Return the index of the cell containing a coordinate, in the
+    * given direction on a reduced level.
+    */
+   int
+   getCellIndex(
+      const hier::BaseGridGeometry& reduced_geometry,
+      const hier::IntVector& ratio_to_level_zero,
+      const tbox::Dimension::dir_t axis,
+      const double coordinate,
+      const bool is_upper) const;
+
+   /*!
+    * @brief Append the reduced boxes of a patch box.
+    *
+    * The boxes appended for one patch box do not overlap.
+    *
+    * @param[out] reduced_boxes
+    * @param[in] box  Box of the patch.
+    * @param[in] region  The region in the reduced index space of the level
+    *                    (unused without region).
+    * @param[in] slice_indices  Index of each slice in the reduced index
+    *                           space of the level.
+    */
+   void
+   computeReducedBoxes(
+      std::vector<hier::Box>& reduced_boxes,
+      const hier::Box& box,
+      const hier::Box& region,
+      const std::vector<int>& slice_indices) const;
+
+   /*!
+    * @brief Allocate the selected components of a reduced patch and fill
+    * them from the patch it was reduced from.
+    */
+   void
+   fillReducedPatch(
+      hier::Patch& reduced_patch,
+      const hier::Patch& patch,
+      const hier::BaseGridGeometry& grid_geometry,
+      const hier::ComponentSelector& components) const;
+
+   /*!
+    * @brief Set up things for the entire class.
+    *
+    * Only called by StartupShutdownManager.
+    */
+   static void
+   initializeCallback();
+
+   /*!
+    * Free static timers.
+    *
+    * Only called by StartupShutdownManager.
+    */
+   static void
+   finalizeCallback();
+
+   const tbox::Dimension d_dim;
+
+   std::string d_object_name;
+
+   /*!
+    * @brief Finest level written, or -1 for all levels.
+    */
+   int d_max_level;
+
+   /*!
+    * @brief Coarsening ratio and the name of the coarsening operator.
+    */
+   hier::IntVector d_coarsen_ratio;
+   std::string d_coarsen_operator;
+
+   /*!
+    * @brief Corners of the written region, if any.
+    */
+   bool d_has_region;
+   std::vector<double> d_region_lower;
+   std::vector<double> d_region_upper;
+
+   /*!
+    * @brief Normal direction and coordinate of each slice.
+    */
+   std::vector<int> d_slice_axes;
+   std::vector<double> d_slice_coordinates;
+
+   /*!
+    * @brief Coarsened grid geometry, built for the last grid geometry
+    * reduced with a coarsening ratio.
+    */
+   std::shared_ptr<hier::BaseGridGeometry> d_grid_geometry;
+   std::shared_ptr<hier::BaseGridGeometry> d_coarsened_grid_geometry;
+
+   /*!
+    * @name Timer objects for performance measurement.
+    */
+   static std::shared_ptr<tbox::Timer> t_reduce_hierarchy;
+
+   static tbox::StartupShutdownManager::Handler
+      s_initialize_finalize_handler;
+
+};
+
+}
+}
+
+#endif
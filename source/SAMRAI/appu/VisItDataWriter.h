@@ -22,20 +22,25 @@
 
 #include "SAMRAI/appu/VisDerivedDataStrategy.h"
 #include "SAMRAI/appu/VisMaterialsDataStrategy.h"
+#include "SAMRAI/appu/VisItDataReduction.h"
 
 #include "SAMRAI/hier/PatchData.h"
 #include "SAMRAI/hier/PatchHierarchy.h"
 #include "SAMRAI/tbox/IOStream.h"
 #include "SAMRAI/tbox/Database.h"
 #include "SAMRAI/tbox/HDFDatabase.h"
+#include "SAMRAI/tbox/MemoryDatabase.h"
+#include "SAMRAI/tbox/MessageStream.h"
 #include "SAMRAI/tbox/Timer.h"
 #include "SAMRAI/tbox/Database.h"
 #include "SAMRAI/tbox/SAMRAI_MPI.h"
 
 #include <string>
 #include <list>
+#include <map>
 #include <vector>
 #include <memory>
+#include <thread>
 
 namespace SAMRAI {
 namespace appu {
@@ -96,7 +101,9 @@ namespace appu {
  *       common dump file.  This can reduce parallel I/O contention.
  *       The default value of this arg is 1.  If the value specified
  *       is greater than the number of processors, then all processors
- *       share a single dump file.
+ *       share a single dump file.  For large parallel runs,
+ *       setCollectiveOutput() makes all processors share a single dump
+ *       file and gathers the summary information collectively.
  *
  *    - Register hierarchy variable data fields using
  *      registerPlotQuantity(). The variables registered may be scalar,
@@ -283,6 +290,18 @@ public:
     * index. It will revert to the supplied type only if it is unable to
     * determine the type from the index.
     *
+    * A positive compression tolerance stores the variable compressed by
+    * LossyFloatCompressor, an error-bounded lossy compressor, through an
+    * HDF5 filter: no written value differs from the (scaled) data, as
+    * converted to float, by more than the tolerance, which is absolute or
+    * relative to the range of the values of each patch.  Readers
+    * decompress the data transparently only if the filter is available
+    * to them.  SAMRAI registers it with
+    * LossyFloatCompressor::registerHDF5Filter(); VisIt and other HDF5
+    * tools (h5py, h5dump) load it from the HDF5 filter plugin installed
+    * in the lib/plugin directory of SAMRAI, which must be listed in the
+    * HDF5_PLUGIN_PATH environment variable.
+    *
     * Data does not need to exist on all patches or all levels.
     *
     * An error results and the program will halt if:
@@ -303,11 +322,17 @@ public:
     * @param variable_centering (optional) "CELL" or "NODE" - used
     *    only when data being registered is not standard cell or
     *    node type.
+    * @param compression_tolerance (optional) zero by default, for
+    *    uncompressed data; largest error of the compressed data
+    * @param compression_tolerance_is_relative (optional) false by
+    *    default; whether the compression tolerance is relative to the
+    *    range of the data of each patch
     *
     * @pre !variable_name.empty()
     * @pre !variable_type.empty()
     * @pre patch_data_index >= -1
     * @pre start_depth_index >= 0
+    * @pre compression_tolerance >= 0.0
     */
    void
    registerPlotQuantity(
@@ -316,7 +341,9 @@ public:
       const int patch_data_index,
       const int start_depth_index = 0,
       const double scale_factor = 1.0,
-      const std::string& variable_centering = "UNKNOWN");
+      const std::string& variable_centering = "UNKNOWN",
+      const double compression_tolerance = 0.0,
+      const bool compression_tolerance_is_relative = false);
 
    /*!
     * @brief This method registers a derived variable with the VisIt data
@@ -719,6 +746,132 @@ public:
       d_write_ghosts = write_ghosts; 
    }
 
+   /*!
+    * @brief Set flag for collective output.
+    *
+    * When true, the processors of each file cluster (see the
+    * number_procs_per_file constructor argument) write their file of
+    * each plot dump together with collective MPI-IO, instead of one
+    * after the other.  A number_procs_per_file of 1, the default, puts
+    * all processors in a single cluster writing a single shared file.
+    * For each file:
+    *
+    * -# Each processor packs its plot data into an in-memory snapshot
+    *    and sends the layout of the snapshot (its groups, small entries
+    *    and the sizes of its data arrays) to the leader of its cluster.
+    * -# The leader creates the HDF5 file with the groups and entries of
+    *    the processors of its cluster, allocating contiguous storage for
+    *    every data array without writing it, and sends each processor
+    *    the file addresses of its arrays.
+    * -# The processors of the cluster write their arrays at those
+    *    addresses with MPI_File_write_at_all(), in pieces of at most
+    *    INT_MAX bytes.
+    *
+    * Only the leaders call HDF5, so a serial HDF5 library suffices.  The
+    * leaders of different clusters create their files concurrently, so
+    * number_procs_per_file bounds the number of groups and datasets a
+    * single processor creates for a dump; the processors write their
+    * data concurrently.  The min/max summary information of all patches
+    * is collected on the VISIT_MASTER with one collective gather instead
+    * of a message per processor, and VisIt reads the dump as before
+    * through the dumps.visit index.
+    *
+    * Collective output cannot be combined with asynchronous output or
+    * with compressed plot quantities, whose storage is not contiguous.
+    * Without MPI, the dump is written as usual.  The default is false.
+    *
+    * @param collective_output  True to write a single shared file
+    */
+   void
+   setCollectiveOutput(bool collective_output)
+   {
+      d_collective_output = collective_output;
+   }
+
+   /*!
+    * @brief Set flag for asynchronous output.
+    *
+    * When true, writePlotData() converts and packs the plot quantities of
+    * the local patches (including derived, material and species data)
+    * into an in-memory snapshot of the processor's part of the dump,
+    * writes the summary file and returns once the snapshot is handed to
+    * an I/O thread, which writes it to the processor's dump file while
+    * the simulation continues.  The writer owns two snapshots and packs
+    * the dumps into them in turn, so the snapshot of a dump is packed
+    * while the previous one is being written.  Only one snapshot is
+    * written at a time: a dump whose snapshot is packed before the
+    * previous write is finished waits for that write before writing the
+    * summary file and handing its snapshot over.  The snapshots keep
+    * their keys' storage from dump to dump; the plot data arrays are
+    * allocated anew for each dump.
+    *
+    * The I/O thread calls HDF5 concurrently with the rest of the
+    * application, so the snapshots are written synchronously unless the
+    * HDF5 library is thread-safe or hdf5_calls_serialized is true.  The
+    * writer itself makes no HDF5 calls while a snapshot is being
+    * written, so an application that makes no HDF5 calls of its own
+    * between writePlotData() and waitForPendingOutput() (restart files
+    * included) may set hdf5_calls_serialized to use the I/O thread with
+    * a HDF5 library that is not thread-safe.
+    *
+    * Asynchronous output cannot be combined with collective output or
+    * with more than one processor per file.  The default is false.
+    *
+    * @param asynchronous_output  True to write plot data in the background
+    * @param hdf5_calls_serialized  True if the application makes no HDF5
+    *                               calls while a snapshot is written
+    *
+    * @see waitForPendingOutput()
+    */
+   void
+   setAsynchronousOutput(
+      bool asynchronous_output,
+      bool hdf5_calls_serialized = false)
+   {
+      d_asynchronous_output = asynchronous_output;
+      d_hdf5_calls_serialized = hdf5_calls_serialized;
+   }
+
+   /*!
+    * @brief Set the reduction applied to the hierarchy before it is
+    * written.
+    *
+    * When set, writePlotData() writes the hierarchy built by
+    * VisItDataReduction::reduceHierarchy() instead of the given one, so
+    * that only the levels, region, slices or coarsened data it selects
+    * are written.  A null pointer, the default, writes the whole
+    * hierarchy.  A reduction cannot be combined with writing ghosts.
+    *
+    * The reduced hierarchy holds only the patch data of the registered
+    * plot quantities.  Derived, material and species data writers see
+    * the reduced patches, so the patch data they read must be given.
+    *
+    * @param data_reduction
+    * @param writer_patch_data_indices  Patch data indices read by the
+    *                                   derived, material and species data
+    *                                   writers.
+    *
+    * @pre each entry of writer_patch_data_indices is >= 0
+    */
+   void
+   setDataReduction(
+      const std::shared_ptr<VisItDataReduction>& data_reduction,
+      const std::vector<int>& writer_patch_data_indices = std::vector<int>())
+   {
+      d_data_reduction = data_reduction;
+      d_writer_patch_data_indices = writer_patch_data_indices;
+   }
+
+   /*!
+    * @brief Wait until the snapshot being written by the I/O thread, if
+    * any, is in its dump file.
+    *
+    * This must be called before the dump files of the last dump are
+    * read.  It is called by the destructor.
+    */
+   void
+   waitForPendingOutput();
+
 private:
    /*
     * Static integer constant describing version of VisIt Data Writer.
@@ -916,6 +1069,9 @@ private:
       //   material state variable treatment?
       //bool d_is_species_state_variable;
       std::vector<int> d_ghost_width;
+      // lossy compression, if the tolerance is positive
+      double d_compression_tolerance;
+      bool d_compression_tolerance_is_relative;
 
       /*
        * Standard information (writer generated)
@@ -1084,6 +1240,80 @@ private:
    void
    dumpWriteBarrierEnd();
 
+   /*
+    * Write the snapshot of the plot data of a processor to a new HDF
+    * file, as a group with the name of the snapshot.  Run by the I/O
+    * thread for asynchronous output.
+    */
+   static void
+   writeSnapshotToHDFFile(
+      const std::string visit_HDFFilename,
+      const std::string database_name,
+      const std::shared_ptr<tbox::Database> snapshot,
+      const std::map<std::string, std::vector<unsigned int> > compressed_keys);
+
+   /*
+    * Write the snapshots of the plot data of the processors of this
+    * file cluster to the file they share with collective MPI-IO.  See
+    * setCollectiveOutput().
+    */
+   void
+   writeSnapshotCollectively(
+      const std::string& visit_HDFFilename,
+      const std::string& database_name,
+      tbox::Database& snapshot);
+
+   /*
+    * Pack the layout of a snapshot into a stream: its groups and small
+    * entries in full, and only the type and size of its float and double
+    * arrays.  The values of these arrays are appended to bulk_data in
+    * their file representation and their sizes in bytes to bulk_sizes,
+    * in the order in which they appear in the layout.
+    */
+   static void
+   packSnapshotLayout(
+      tbox::Database& snapshot,
+      tbox::MessageStream& layout,
+      std::vector<char>& bulk_data,
+      std::vector<size_t>& bulk_sizes);
+
+   /*
+    * Create the groups and entries described by a layout packed by
+    * packSnapshotLayout() in an HDF database.  Storage is allocated for
+    * the float and double arrays without writing them, and their file
+    * addresses are appended to addresses.
+    */
+   static void
+   createDatabaseFromLayout(
+      tbox::MessageStream& layout,
+      tbox::HDFDatabase& dst,
+      std::vector<unsigned long long>& addresses);
+
+   /*
+    * Recursively copy the contents of one database into another.  Float
+    * arrays whose key is in compressed_keys are written compressed with
+    * the associated filter parameters.
+    */
+   static void
+   copyDatabase(
+      tbox::Database& src,
+      tbox::Database& dst,
+      const std::map<std::string, std::vector<unsigned int> >&
+      compressed_keys);
+
+   /*
+    * Write the data of one component of a plot variable on a patch,
+    * compressed if the variable was registered with a compression
+    * tolerance and the database is an HDF database.
+    */
+   static void
+   putPlotVariableData(
+      tbox::Database& patch_HDFGroup,
+      const VisItItem& plotitem,
+      const std::string& vname,
+      const float* data,
+      const int size);
+
    /*
     * Write summary data for VisIt to HDF file.
     */
@@ -1106,6 +1336,17 @@ private:
       const int coarsest_plot_level,
       const int finest_plot_level);
 
+   /*
+    * Version of exchangeMinMaxPatchInformation() for collective output.
+    * The min/max information of all workers is collected with a single
+    * gather and unpacked on the VISIT_MASTER in one pass over the patches.
+    */
+   void
+   gatherMinMaxPatchInformation(
+      const std::shared_ptr<hier::PatchHierarchy>& hierarchy,
+      const int coarsest_plot_level,
+      const int finest_plot_level);
+
    /*
     * Pack dim patch data into 1D double precision buffer,
     * eliminating ghost data if necessary
@@ -1291,6 +1532,34 @@ private:
    int d_my_rank_in_file_cluster;
    int d_number_files_this_file_cluster;
 
+   /*
+    * Number of processors per file given to the constructor, and whether
+    * all processors write a single shared file (see setCollectiveOutput()).
+    */
+   int d_number_procs_per_file;
+   bool d_collective_output;
+
+   /*
+    * Whether plot data is written by an I/O thread (see
+    * setAsynchronousOutput()), and the thread writing the last snapshot.
+    */
+   bool d_asynchronous_output;
+   bool d_hdf5_calls_serialized;
+   std::thread d_output_thread;
+
+   /*
+    * Snapshots the dumps are packed into in turn for asynchronous output,
+    * and the index of the one the next dump is packed into.
+    */
+   std::shared_ptr<tbox::MemoryDatabase> d_snapshots[2];
+   int d_next_snapshot;
+
+   /*
+    * Reduction of the hierarchy written (see setDataReduction()).
+    */
+   std::shared_ptr<VisItDataReduction> d_data_reduction;
+   std::vector<int> d_writer_patch_data_indices;
+
    /*
     * Number of registered VisIt variables, materials, and species.
     * Each regular and derived and variable (i.e. variables registered with
@@ -1348,6 +1617,9 @@ private:
    //! @brief Timer for writePlotData().
    static std::shared_ptr<tbox::Timer> t_write_plot_data;
 
+   //! @brief Timer for waitForPendingOutput().
+   static std::shared_ptr<tbox::Timer> t_wait_for_pending_output;
+
    /*!
     * @brief Initialize static objects and register shutdown routine.
     *
@@ -1358,6 +1630,8 @@ private:
    {
       t_write_plot_data = tbox::TimerManager::getManager()->getTimer(
             "appu:VisItDataWriter::writePlotData()");
+      t_wait_for_pending_output = tbox::TimerManager::getManager()->getTimer(
+            "appu:VisItDataWriter::waitForPendingOutput()");
    }
 
    /*!
@@ -1369,6 +1643,7 @@ private:
    finalizeCallback()
    {
       t_write_plot_data.reset();
+      t_wait_for_pending_output.reset();
    }
 
    /*
@@ -697,6 +697,21 @@ public:
          var, op_name);
    }
 
+   /*!
+    * @brief Return whether a coarsening operator with the given name is
+    * registered for the given variable.
+    *
+    * @param[in]     var
+    * @param[in]     op_name The string identifier of the coarsening operator.
+    */
+   bool
+   hasCoarsenOperator(
+      const std::shared_ptr<Variable>& var,
+      const std::string& op_name) const
+   {
+      return d_transfer_operator_registry->hasCoarsenOperator(var, op_name);
+   }
+
    /*!
     * @brief Lookup function for refinement operator.
     *
@@ -1846,6 +1861,109 @@ private:
       const IntVector& gcw,
       const BoxContainer& singularity);
 
+   /*!
+    * @brief Domain boxes against which the boundary boxes of the patches
+    * of levels with one ratio to level zero are computed.
+    *
+    * These depend only on the ratio, the periodic shift and the block
+    * configuration, so they are built once, with search trees, and
+    * reused for every level with that ratio until the domain description
+    * changes.
+    */
+   struct BoundaryBoxCatalog {
+      explicit BoundaryBoxCatalog(
+         const IntVector& ratio):
+         d_ratio(ratio),
+         d_periodic_shift(ratio.getDim(), 0),
+         d_has_search_domains(false)
+      {
+      }
+
+      IntVector d_ratio;
+
+      /*!
+       * @brief Periodic shift the search domains were built for.
+       */
+      IntVector d_periodic_shift;
+
+      bool d_has_search_domains;
+
+      /*!
+       * @brief For each block, the domain of the level, grown by the
+       * periodic shift when the domain is periodic.
+       */
+      std::vector<BoxContainer> d_search_domains;
+
+      /*!
+       * @brief For each block of a multiblock domain, the pseudo domain
+       * and singularity boxes of the level given to
+       * adjustBoundaryBoxesOnPatch().
+       */
+      std::vector<BoxContainer> d_pseudo_domains;
+      std::vector<BoxContainer> d_singularities;
+   };
+
+   /*!
+    * @brief Return the boundary box catalog of levels with the ratio to
+    * level zero of the given level, creating an empty one if needed.
+    */
+   BoundaryBoxCatalog&
+   getBoundaryBoxCatalog(
+      const PatchLevel& level) const;
+
+   /*!
+    * @brief Release all boundary box catalogs.
+    *
+    * Called when the physical domain, periodic shift or block
+    * configuration changes.
+    */
+   void
+   clearBoundaryBoxCatalogs();
+
+   /*!
+    * @brief Build, for each block, the domain boxes against which
+    * boundary boxes are computed.
+    *
+    * @param[out] search_domains
+    * @param[in]  domain  Physical domain of each block.
+    * @param[in]  periodic_shift
+    */
+   void
+   buildBoundarySearchDomains(
+      std::vector<BoxContainer>& search_domains,
+      const std::vector<BoxContainer>& domain,
+      const IntVector& periodic_shift) const;
+
+   /*!
+    * @brief Compute the boundary boxes of the patches of a level against
+    * search domains built by buildBoundarySearchDomains().
+    *
+    * See computeBoundaryBoxesOnLevel() for the other arguments.
+    */
+   void
+   computeLevelBoundaryBoxes(
+      std::map<BoxId, PatchBoundaries>& boundaries,
+      const PatchLevel& level,
+      const IntVector& periodic_shift,
+      const IntVector& ghost_width,
+      const std::vector<BoxContainer>& domain,
+      const std::vector<BoxContainer>& search_domains,
+      bool do_all_patches) const;
+
+   /*!
+    * @brief Compute the boundary boxes of a box against a search domain
+    * built by buildBoundarySearchDomains().
+    *
+    * See getBoundaryBoxes() for the other arguments.
+    */
+   void
+   computeBoundaryBoxes(
+      PatchBoundaries& patch_boundaries,
+      const Box& box,
+      const BoxContainer& search_domain,
+      const IntVector& ghosts,
+      const IntVector& periodic_shift) const;
+
    /*!
     * @brief Set the transformations between block neighbors for every level
     *
@@ -1988,6 +2106,13 @@ private:
     */
    bool d_has_enhanced_connectivity;
 
+   /*!
+    * @brief Boundary box catalogs, one for each ratio to level zero for
+    * which levels have been given boundary boxes.
+    */
+   mutable std::vector<std::shared_ptr<BoundaryBoxCatalog> >
+   d_boundary_box_catalogs;
+
    static std::shared_ptr<tbox::Timer> t_find_patches_touching_boundaries;
    static std::shared_ptr<tbox::Timer> t_touching_boundaries_init;
    static std::shared_ptr<tbox::Timer> t_touching_boundaries_loop;
@@ -1996,6 +2121,7 @@ private:
    static std::shared_ptr<tbox::Timer> t_set_geometry_data_on_patches;
    static std::shared_ptr<tbox::Timer> t_compute_boundary_boxes_on_level;
    static std::shared_ptr<tbox::Timer> t_get_boundary_boxes;
+   static std::shared_ptr<tbox::Timer> t_build_boundary_box_catalog;
    static std::shared_ptr<tbox::Timer> t_adjust_multiblock_patch_level_boundaries;
 
    /*
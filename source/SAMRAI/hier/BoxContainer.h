@@ -697,6 +697,25 @@ private:
       return d_list.empty();
    }
 
+   /*!
+    * @brief Return an estimate of the memory used by the boxes of the
+    * container, in bytes.
+    *
+    * The estimate counts the list nodes holding the boxes and, for an
+    * ordered container, the nodes of the ordering.  It does not count the
+    * search tree built for overlap searches.
+    */
+   size_t
+   getMemoryFootprint() const
+   {
+      // List nodes have two links, tree nodes a color and three links.
+      size_t bytes = d_list.size() * (sizeof(Box) + 2 * sizeof(void *));
+      if (d_ordered) {
+         bytes += d_set.size() * (sizeof(Box *) + 4 * sizeof(void *));
+      }
+      return bytes;
+   }
+
    /*!
     * @brief Return a const_iterator pointing to the start of the container.
     *
@@ -17,6 +17,7 @@
 #include "SAMRAI/hier/BoxLevelHandle.h"
 #include "SAMRAI/hier/BaseGridGeometry.h"
 #include "SAMRAI/hier/PersistentOverlapConnectors.h"
+#include "SAMRAI/tbox/MemoryAccount.h"
 #include "SAMRAI/tbox/SAMRAI_MPI.h"
 #include "SAMRAI/tbox/SAMRAIManager.h"
 #include "SAMRAI/tbox/Timer.h"
@@ -1020,6 +1021,7 @@ public:
          d_global_boxes.insert(box);
       }
       d_boxes.insert(box);
+      updateMemoryAccount();
    }
 
    /*!
@@ -1136,6 +1138,7 @@ public:
             << std::endl);
       }
       d_boxes.erase(box);
+      updateMemoryAccount();
    }
 
    /*!
@@ -1610,6 +1613,32 @@ public:
       return d_locked;
    }
 
+   /*!
+    * @brief Set the hierarchy level number under which the boxes are
+    * accounted in tbox::MemoryAccountant.
+    *
+    * PatchLevel sets it to its level number.  It defaults to
+    * tbox::MemoryAccountant::NO_LEVEL.  Connectors are accounted under
+    * the level of their base.
+    *
+    * @param[in] level_number
+    */
+   void
+   setMemoryAccountLevel(
+      const int level_number)
+   {
+      d_memory_account.setLevel(level_number);
+   }
+
+   /*!
+    * @brief Return the level number under which the boxes are accounted.
+    */
+   int
+   getMemoryAccountLevel() const
+   {
+      return d_memory_account.getLevel();
+   }
+
    //@{
 
    /*!
@@ -1879,6 +1908,19 @@ private:
          getTimer("hier::BoxLevel::acquireRemoteBoxes()");
       t_cache_global_reduced_data = tbox::TimerManager::getManager()->
          getTimer("hier::BoxLevel::cacheGlobalReducedData()");
+      s_memory_category = tbox::MemoryAccountant::getManager()->
+         getCategory("hier::BoxLevel");
+   }
+
+   /*!
+    * @brief Set the footprint of the local and global boxes in the memory
+    * account.
+    */
+   void
+   updateMemoryAccount()
+   {
+      d_memory_account.setBytes(d_boxes.getMemoryFootprint()
+         + d_global_boxes.getMemoryFootprint());
    }
 
    /*!
@@ -2057,6 +2099,11 @@ private:
    static std::shared_ptr<tbox::Timer> t_acquire_remote_boxes;
    static std::shared_ptr<tbox::Timer> t_cache_global_reduced_data;
 
+   /*!
+    * @brief Memory category of BoxLevels.
+    */
+   static int s_memory_category;
+
    /*!
     * @brief std::shared_ptr to the grid geometry associated with this
     * object.
@@ -2065,6 +2112,11 @@ private:
 
    bool d_locked;
 
+   /*!
+    * @brief Footprint of the boxes.
+    */
+   tbox::MemoryAccount d_memory_account;
+
    /*!
     * @brief A LocalId object with value of -1.
     */
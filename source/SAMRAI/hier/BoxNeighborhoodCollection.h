@@ -129,6 +129,12 @@ private:
     */
    HeadBoxLinkCt d_nbr_link_ct;
 
+   /*!
+    * @brief The number of links between base and head Boxes, which is the
+    * number of neighbors in all neighborhoods.
+    */
+   size_t d_num_links;
+
 public:
    // Constructors.
 
@@ -1096,6 +1102,25 @@ private:
       return static_cast<int>(d_base_boxes.size());
    }
 
+   /*!
+    * @brief Returns an estimate of the memory used by the neighborhoods,
+    * in bytes.
+    *
+    * The estimate counts the nodes of the pools of base and head Boxes and
+    * of the links between them.
+    */
+   size_t
+   getMemoryFootprint() const
+   {
+      // Tree nodes have a color and three links.
+      const size_t node = 4 * sizeof(void *);
+      return d_base_boxes.size() * (sizeof(BoxId) + node)
+             + d_adj_list.size() * (sizeof(AdjList::value_type) + node)
+             + d_nbrs.size() * (sizeof(Box) + node)
+             + d_nbr_link_ct.size() * (sizeof(HeadBoxLinkCt::value_type) + node)
+             + d_num_links * (sizeof(const Box *) + node);
+   }
+
    /*!
     * @brief Returns true if the neighborhood of the base Box with the
     * supplied BoxId is empty.
@@ -17,6 +17,7 @@
 #include "SAMRAI/hier/BoxLevelHandle.h"
 #include "SAMRAI/hier/BoxContainer.h"
 #include "SAMRAI/hier/BoxNeighborhoodCollection.h"
+#include "SAMRAI/tbox/MemoryAccount.h"
 #include "SAMRAI/tbox/Timer.h"
 
 #include <set>
@@ -179,6 +180,7 @@ public:
          d_base_handle.reset();
          d_head_handle.reset();
          d_parallel_state = BoxLevel::DISTRIBUTED;
+         updateMemoryAccount();
       }
    }
 
@@ -190,6 +192,7 @@ public:
    {
       d_relationships.clear();
       d_global_relationships.clear();
+      updateMemoryAccount();
    }
 
    /*!
@@ -564,6 +567,7 @@ public:
    {
       TBOX_ASSERT(box_id.getOwnerRank() == d_mpi.getRank());
       d_relationships.insert(box_id, neighbor);
+      updateMemoryAccount();
    }
 
    /*!
@@ -581,6 +585,7 @@ public:
    {
       TBOX_ASSERT(base_box_itr->getOwnerRank() == d_mpi.getRank());
       d_relationships.insert(base_box_itr, neighbor);
+      updateMemoryAccount();
    }
 
    /*!
@@ -596,6 +601,7 @@ public:
    {
       TBOX_ASSERT(box_id.getOwnerRank() == d_mpi.getRank());
       d_relationships.erase(box_id);
+      updateMemoryAccount();
    }
 
    /*!
@@ -608,6 +614,7 @@ public:
       if (d_parallel_state == BoxLevel::GLOBALIZED) {
          d_global_relationships.erasePeriodicNeighbors();
       }
+      updateMemoryAccount();
    }
 
    /*!
@@ -617,6 +624,7 @@ public:
    removePeriodicLocalNeighbors()
    {
       d_relationships.erasePeriodicNeighbors();
+      updateMemoryAccount();
    }
 
    /*!
@@ -649,7 +657,9 @@ public:
       const BoxId& box_id)
    {
       TBOX_ASSERT(box_id.getOwnerRank() == d_mpi.getRank());
-      return d_relationships.insert(box_id).first;
+      NeighborhoodIterator base_box_itr = d_relationships.insert(box_id).first;
+      updateMemoryAccount();
+      return base_box_itr;
    }
 
    /*!
@@ -660,6 +670,7 @@ public:
    {
       d_relationships.eraseEmptyNeighborhoods();
       d_global_data_up_to_date = false;
+      updateMemoryAccount();
    }
 
    /*!
@@ -1138,6 +1149,19 @@ public:
       return d_transpose;
    }
 
+   /*!
+    * @brief Set the memory category in which the relationships are
+    * accounted, from tbox::MemoryAccountant::getCategory().
+    *
+    * Connectors are accounted as "hier::Connector" unless set otherwise.
+    */
+   void
+   setMemoryCategory(
+      int category)
+   {
+      d_memory_account.setCategory(category);
+   }
+
    /*!
     * @brief Returns the transpose of this Connector if it exists.
     *
@@ -1636,6 +1660,8 @@ private:
          getTimer("hier::Connector::cacheGlobalReducedData()");
       t_find_overlaps_rbbt = tbox::TimerManager::getManager()->
          getTimer("hier::Connector::findOverlaps_rbbt()");
+      s_memory_category = tbox::MemoryAccountant::getManager()->
+         getCategory("hier::Connector");
    }
 
    /*!
@@ -1651,6 +1677,21 @@ private:
       t_find_overlaps_rbbt.reset();
    }
 
+   /*!
+    * @brief Set the footprint of the relationships in the memory account,
+    * on the level of the base if the base is still attached.
+    */
+   void
+   updateMemoryAccount()
+   {
+      if (d_base_handle && d_base_handle->isAttached()) {
+         d_memory_account.setLevel(
+            d_base_handle->getBoxLevel().getMemoryAccountLevel());
+      }
+      d_memory_account.setBytes(d_relationships.getMemoryFootprint()
+         + d_global_relationships.getMemoryFootprint());
+   }
+
    /*!
     * @brief Read the neighborhoods from a restart database.
     *
@@ -1661,6 +1702,7 @@ private:
       tbox::Database& restart_db)
    {
       d_relationships.getFromRestart(restart_db);
+      updateMemoryAccount();
    }
 
    /*!
@@ -1800,10 +1842,21 @@ private:
 
    bool d_owns_transpose;
 
+   /*!
+    * @brief Footprint of the relationships, accounted on the level of the
+    * base.
+    */
+   tbox::MemoryAccount d_memory_account;
+
    static std::shared_ptr<tbox::Timer> t_acquire_remote_relationships;
    static std::shared_ptr<tbox::Timer> t_cache_global_reduced_data;
    static std::shared_ptr<tbox::Timer> t_find_overlaps_rbbt;
 
+   /*!
+    * @brief Memory category of Connectors.
+    */
+   static int s_memory_category;
+
    static tbox::StartupShutdownManager::Handler
       s_initialize_finalize_handler;
 
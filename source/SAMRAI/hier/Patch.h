@@ -23,8 +23,11 @@
 #include "SAMRAI/hier/VariableContext.h"
 #include "SAMRAI/hier/VariableDatabase.h"
 #include "SAMRAI/tbox/Database.h"
+#include "SAMRAI/tbox/MemoryAccount.h"
+#include "SAMRAI/tbox/StartupShutdownManager.h"
 #include "SAMRAI/tbox/Utilities.h"
 
+#include <algorithm>
 #include <vector>
 #include <memory>
 
@@ -216,7 +219,13 @@ public:
    {
       TBOX_ASSERT_OBJDIM_EQUALITY2(*this, *data);
       TBOX_ASSERT((id >= 0) && (id < numPatchData()));
+      if (d_patch_data[id]) {
+         accountPatchData(id, false);
+      }
       d_patch_data[id] = data;
+      if (d_patch_data[id]) {
+         accountPatchData(id, true);
+      }
    }
 
    /*!
@@ -305,7 +314,8 @@ public:
    {
       TBOX_ASSERT((id >= 0) &&
          (id < getPatchDescriptor()->getMaxNumberRegisteredComponents()));
-      if (id < numPatchData()) {
+      if (id < numPatchData() && d_patch_data[id]) {
+         accountPatchData(id, false);
          d_patch_data[id].reset();
       }
    }
@@ -422,6 +432,7 @@ public:
       const int level_number)
    {
       d_patch_level_number = level_number;
+      d_memory_account.setLevel(level_number);
    }
    /*!
     * @brief Determine if the level holding this patch resides in a hierarchy.
@@ -555,6 +566,33 @@ private:
    operator = (
       const Patch&);
 
+   /*
+    * Add the footprint of component id, as given by its factory, to the
+    * memory account of the patch data or remove it from the account.
+    */
+   void
+   accountPatchData(
+      const int id,
+      const bool allocated)
+   {
+      const std::shared_ptr<PatchDataFactory>& factory(
+         d_descriptor->getPatchDataFactory(id));
+      if (factory) {
+         const size_t bytes = factory->getSizeOfMemory(d_box);
+         const size_t accounted = d_memory_account.getBytes();
+         d_memory_account.setBytes(allocated ?
+            accounted + bytes : accounted - std::min(bytes, accounted));
+      }
+   }
+
+   /*
+    * Set up the memory category of patch data.
+    *
+    * Only called by StartupShutdownManager.
+    */
+   static void
+   initializeCallback();
+
    /*
     * The box defining the extent of this patch.
     */
@@ -570,6 +608,17 @@ private:
 
    bool d_patch_in_hierarchy;
 
+   /*
+    * Footprint of the allocated patch data, accounted as "hier::PatchData"
+    * on the level of the patch.
+    */
+   tbox::MemoryAccount d_memory_account;
+
+   static int s_memory_category;
+
+   static tbox::StartupShutdownManager::Handler
+      s_initialize_handler;
+
 };
 
 }
@@ -204,6 +204,9 @@ public:
       const int level)
    {
       d_level_number = level;
+      if (d_box_level) {
+         d_box_level->setMemoryAccountLevel(d_level_number);
+      }
       for (Iterator p(begin()); p != end(); ++p) {
          p->setPatchLevelNumber(d_level_number);
       }
@@ -12,6 +12,7 @@
 
 #include "SAMRAI/SAMRAI_config.h"
 #include "SAMRAI/hier/IntVector.h"
+#include "SAMRAI/tbox/StartupShutdownManager.h"
 
 #include <vector>
 
@@ -107,6 +108,14 @@ public:
       bool create_empty_neighbor_containers);
 
 private:
+   /*!
+    * @brief Set up the memory category of the cached Connectors.
+    *
+    * Only called by StartupShutdownManager.
+    */
+   static void
+   initializeCallback();
+
    /*!
     * @brief Deletes all Connectors to and from this object
     */
@@ -398,6 +407,15 @@ private:
     */
    static size_t s_num_implicit_global_searches;
 
+   /*
+    * @brief Memory category of the cached Connectors, which are
+    * accounted apart from other Connectors.
+    */
+   static int s_memory_category;
+
+   static tbox::StartupShutdownManager::Handler
+      s_initialize_handler;
+
 };
 
 }
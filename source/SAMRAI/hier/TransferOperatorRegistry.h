@@ -136,6 +136,20 @@ public:
       const std::shared_ptr<Variable>& var,
       const std::string& op_name);
 
+   /*!
+    * @brief Return whether a coarsening operator with the given name is
+    * registered for the given variable.
+    *
+    * @param[in]  var
+    * @param[in]  op_name The string identifier of the coarsening operator.
+    *
+    * @pre var
+    */
+   bool
+   hasCoarsenOperator(
+      const std::shared_ptr<Variable>& var,
+      const std::string& op_name) const;
+
    /*!
     * @brief Lookup function for refinement operator.
     *
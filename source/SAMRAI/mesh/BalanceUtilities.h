@@ -441,6 +441,14 @@ struct BalanceUtilities {
     * To be used for performance evaluation.  Not recommended for
     * general use.
     *
+    * If @c ranks_per_node is greater than 1, the summary also gives
+    * the balance between shared-memory nodes, assumed to hold equally
+    * sized, contiguous ranges of ranks: the min/max node loads and the
+    * worst load of a process relative to its node average.  If a
+    * BoxLevel is also given, the summary gives the number of cell
+    * faces its boxes share with boxes on other nodes (the inter-node
+    * surface area) next to the total surface area between boxes.
+    *
     * @param[in] local_loads Sequence of workloads of the local
     * process.  The size of @c local_loads is the number times load
     * balancing has been used.  It must be the same across all
@@ -449,12 +457,22 @@ struct BalanceUtilities {
     * @param[in] mpi Represents all processes involved in the load balancing.
     *
     * @param[in] output_stream
+    *
+    * @param[in] ranks_per_node
+    *
+    * @param[in] box_level Optional BoxLevel for reporting the
+    * inter-node surface area.  Must have no periodic images.
+    *
+    * @pre ranks_per_node > 0
+    * @pre mpi.getSize() % ranks_per_node == 0
     */
    static void
    reduceAndReportLoadBalance(
       const std::vector<double>& local_loads,
       const tbox::SAMRAI_MPI& mpi,
-      std::ostream& output_stream = tbox::plog);
+      std::ostream& output_stream = tbox::plog,
+      const int ranks_per_node = 1,
+      const hier::BoxLevel* box_level = 0);
 
    //@}
 
@@ -14,6 +14,7 @@
 #include "SAMRAI/SAMRAI_config.h"
 #include "SAMRAI/hier/ProcessorMapping.h"
 #include "SAMRAI/mesh/LoadBalanceStrategy.h"
+#include "SAMRAI/mesh/SpatialKey.h"
 #include "SAMRAI/tbox/Database.h"
 #include "SAMRAI/tbox/Timer.h"
 #include "SAMRAI/tbox/Utilities.h"
@@ -110,6 +111,19 @@ namespace mesh {
  *   Tile size when using tile mode.  Tile mode restricts box cuts
  *   to tile boundaries.
  *
+ *    - \b distributed_pack
+ *       Boolean flag to use the distributed variant of the algorithm for
+ *       levels with uniform workloads.  Each process chops its own boxes,
+ *       the chopped boxes are sorted along the Morton-type curve used by
+ *       the "SPATIAL" method with a parallel sample sort, and each process
+ *       gets a contiguous segment of the curve with its share of the
+ *       prefix-summed workload.  No process ever holds the global box list,
+ *       so this scales to many more processes than the default, which
+ *       gathers all boxes to all processes.  The single-box optimization
+ *       (see ignore_level_box_union_is_single_box and processor_layout)
+ *       and bin_pack_method are not used in this mode.  Levels with
+ *       non-uniform workloads always use the default algorithm.
+ *
  * <b> Details: </b> <br>
  * <table>
  *   <tr>
@@ -168,6 +182,14 @@ namespace mesh {
  *     <td>opt</td>
  *     <td>Not written to restart. Value in input db used.</td>
  *   </tr>
+ *   <tr>
+ *     <td>distributed_pack</td>
+ *     <td>bool</td>
+ *     <td>FALSE</td>
+ *     <td>TRUE, FALSE</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
  * </table>
  *
  * A sample input file entry might look like:
@@ -182,7 +204,8 @@ namespace mesh {
  * Performance warning: This class implements a sequential algorithm.
  * The time it takes to this balancer increases with processor count.
  * However, you can probably use this load balancer on up to 1K
- * processors before its performance degrades noticably.
+ * processors before its performance degrades noticably.  Set
+ * distributed_pack to TRUE to avoid this for uniform workloads.
  *
  * @see LoadBalanceStrategy
  */
@@ -606,6 +629,84 @@ private:
       std::vector<double>& weights_out,
       const tbox::SAMRAI_MPI& mpi) const;
 
+   /*!
+    * @brief Distributed load balancing of a BoxLevel with uniform
+    * workload.
+    *
+    * Used in place of loadBalanceBoxes() when distributed_pack is set.
+    * Boxes are chopped locally, sorted with sampleSortBoxes() and
+    * assigned to processes by prefix-summed workload.  The Connector
+    * balance<==>anchor is recomputed for the new BoxLevel.
+    *
+    * @pre !balance_to_anchor || balance_to_anchor->hasTranspose()
+    */
+   void
+   loadBalanceBoxLevelDistributed(
+      hier::BoxLevel& balance_box_level,
+      hier::Connector* balance_to_anchor,
+      int level_number,
+      const hier::IntVector& min_size,
+      const hier::IntVector& max_size,
+      const hier::BoxLevel& domain_box_level,
+      const hier::IntVector& bad_interval,
+      const hier::IntVector& cut_factor) const;
+
+   /*!
+    * @brief Sort boxes distributed over the processes of mpi along the
+    * Morton-type curve through their centers.
+    *
+    * On return, the boxes are sorted locally and every box on process
+    * p precedes every box on process p+1.  Uses a sample sort with at
+    * most s_samples_per_rank samples from each process.
+    *
+    * @param[in,out] boxes
+    * @param[in] offset Index subtracted from box centers to make the
+    * coordinates non-negative.  Must be the same on all processes.
+    * @param[in] mpi
+    */
+   void
+   sampleSortBoxes(
+      std::vector<hier::Box>& boxes,
+      const hier::Index& offset,
+      const tbox::SAMRAI_MPI& mpi) const;
+
+   /*!
+    * @brief Locally sort boxes along the Morton-type curve through
+    * their centers and return their keys in the same order.
+    */
+   void
+   sortBoxesBySpatialKey(
+      std::vector<hier::Box>& boxes,
+      std::vector<SpatialKey>& keys,
+      const hier::Index& offset) const;
+
+   /*!
+    * @brief Compute the spatial key of a box center relative to offset.
+    */
+   SpatialKey
+   computeSpatialKey(
+      const hier::Index& center,
+      const hier::Index& offset) const;
+
+   /*!
+    * @brief Send each box to a given rank.
+    *
+    * @param[in] boxes Boxes to send.
+    * @param[in] dest_ranks Destination of each box, in non-decreasing
+    * order.
+    * @param[out] recv_boxes Boxes received, ordered by the sender's
+    * rank and then by their order on the sender.
+    * @param[in] mpi
+    *
+    * @pre boxes.size() == dest_ranks.size()
+    */
+   void
+   exchangeBoxesByRank(
+      const std::vector<hier::Box>& boxes,
+      const std::vector<int>& dest_ranks,
+      std::vector<hier::Box>& recv_boxes,
+      const tbox::SAMRAI_MPI& mpi) const;
+
    /*
     * Utility functions to determine parameter values for level.
     */
@@ -703,6 +804,18 @@ private:
     */
    hier::IntVector d_tile_size;
 
+   /*!
+    * @brief Whether to use the distributed algorithm for uniform
+    * workloads.  See input parameter distributed_pack.
+    */
+   bool d_distributed_pack;
+
+   /*!
+    * @brief Maximum number of samples each process contributes to
+    * choosing the splitters in sampleSortBoxes().
+    */
+   static const int s_samples_per_rank = 16;
+
    mutable std::vector<double> d_load_stat;
 
    /*
@@ -716,6 +829,8 @@ private:
    std::shared_ptr<tbox::Timer> t_bin_pack_boxes_sort;
    std::shared_ptr<tbox::Timer> t_bin_pack_boxes_pack;
    std::shared_ptr<tbox::Timer> t_chop_boxes;
+   std::shared_ptr<tbox::Timer> t_distributed_pack;
+   std::shared_ptr<tbox::Timer> t_sample_sort;
 };
 
 }
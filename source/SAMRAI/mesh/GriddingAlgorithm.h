@@ -145,6 +145,30 @@ namespace mesh {
  *      This is an option to save the tags that are used to create a new
  *      fine level in CellData on that level.
  *
+ *   - \b    pipeline_level_regrid
+ *      when regridding, start filling the data of each new level but
+ *      complete the fill only after the next coarser level's tags have been
+ *      buffered, clustered and load balanced.  This overlaps the old-to-new
+ *      data transfer of a level with the regrid work of the next coarser
+ *      level.  Requires the TagAndInitializeStrategy to support split-phase
+ *      level initialization; otherwise it has no effect.
+ *
+ *   - \b    skip_unneeded_regrids
+ *      when regridding, skip building a new finer level if the existing
+ *      finer level already covers the tags of the tag level.  Clustering,
+ *      load balancing and data movement for that level are then avoided
+ *      and the existing level is kept.  Because cells under the existing
+ *      finer level are pre-tagged, this compares only tags added outside
+ *      the existing finer level.  The number of skipped regrids is reported
+ *      by printStatistics().
+ *
+ *   - \b    regrid_skip_tolerance
+ *      fraction of tagged cells that may lie outside the existing finer
+ *      level for a regrid to be skipped.  Zero means all tags must be
+ *      covered.  The tolerance does not apply to tags added to properly
+ *      nest the next finer level; those must always be covered.  Only
+ *      used if skip_unneeded_regrids is TRUE.
+ *
  * <b> Details: </b> <br>
  * <table>
  *   <tr>
@@ -219,6 +243,30 @@ namespace mesh {
  *     <td>opt</td>
  *     <td>Parameter read from restart db will not be overridden by input db</td>
  *   </tr>
+ *   <tr>
+ *     <td>pipeline_level_regrid</td>
+ *     <td>bool</td>
+ *     <td>FALSE</td>
+ *     <td>TRUE, FALSE</td>
+ *     <td>opt</td>
+ *     <td>Parameter read from restart db may be overridden by input db</td>
+ *   </tr>
+ *   <tr>
+ *     <td>skip_unneeded_regrids</td>
+ *     <td>bool</td>
+ *     <td>FALSE</td>
+ *     <td>TRUE, FALSE</td>
+ *     <td>opt</td>
+ *     <td>Parameter read from restart db may be overridden by input db</td>
+ *   </tr>
+ *   <tr>
+ *     <td>regrid_skip_tolerance</td>
+ *     <td>double</td>
+ *     <td>0.0</td>
+ *     <td>0 <= regrid_skip_tolerance < 1</td>
+ *     <td>opt</td>
+ *     <td>Parameter read from restart db may be overridden by input db</td>
+ *   </tr>
  * </table>
  *
  * All values read in from a restart database may be overriden by input
@@ -494,7 +542,8 @@ public:
       const std::shared_ptr<tbox::Database>& restart_db) const;
 
    /*
-    * @brief Write out statistics recorded on numbers of cells and patches generated.
+    * @brief Write out statistics recorded on numbers of cells and patches
+    * generated and on regrids skipped.
     */
    void
    printStatistics(
@@ -618,6 +667,38 @@ private:
       std::shared_ptr<const hier::Connector> tag_to_finer,
       std::shared_ptr<hier::BoxLevel> new_box_level);
 
+   /*!
+    * @brief Complete the data initialization of the level whose
+    * initialization was started but not finished by
+    * regridFinerLevel_createAndInstallNewLevel, if there is one.
+    */
+   void
+   finalizePendingLevelDataInitialization();
+
+   /*!
+    * @brief Determine whether the existing level tag_ln+1 covers the
+    * tags on level tag_ln well enough that it need not be rebuilt.
+    *
+    * A cheap global measure is used: the fraction of user tags not
+    * under level tag_ln+1 must not exceed d_regrid_skip_tolerance.
+    * Tags in the nesting footprint of level tag_ln+2 must all be under
+    * level tag_ln+1, whatever the tolerance, so that keeping level
+    * tag_ln+1 cannot break proper nesting.  This is collective over
+    * the tag level's communicator.
+    *
+    * @param[in] tag_ln
+    * @param[in] tag_to_nested Connector from level tag_ln to level
+    * tag_ln+2, used to find the nesting footprint.  Unused if level
+    * tag_ln+2 does not exist.
+    *
+    * @pre d_hierarchy->finerLevelExists(tag_ln)
+    * @pre !d_hierarchy->finerLevelExists(tag_ln + 1) || tag_to_nested
+    */
+   bool
+   finerLevelCoversTags(
+      const int tag_ln,
+      const std::shared_ptr<hier::Connector>& tag_to_nested) const;
+
    /*!
     * @brief Set all tags on a level to a given value.
     *
@@ -1371,6 +1452,23 @@ private:
     */
    bool d_save_tag_data; 
 
+   /*
+    * Whether to overlap the data fill of each new level with the regrid
+    * of the next coarser level, and the number of the level whose data
+    * initialization is pending (-1 if none).
+    */
+   bool d_pipeline_level_regrid;
+   int d_pending_init_ln;
+
+   /*
+    * Regrid skipping controls, and per-level counts of the times a
+    * level was considered for regridding and of the regrids skipped.
+    */
+   bool d_skip_unneeded_regrids;
+   double d_regrid_skip_tolerance;
+   std::vector<int> d_num_regrids_considered;
+   std::vector<int> d_num_regrids_skipped;
+
    //@{
    //! @name Used for evaluating peformance.
    bool d_barrier_and_time;
@@ -1420,6 +1518,7 @@ private:
    std::shared_ptr<tbox::Timer> t_process_error;
    std::shared_ptr<tbox::Timer> t_enforce_overflow_nesting;
    std::shared_ptr<tbox::Timer> t_reset_hier;
+   std::shared_ptr<tbox::Timer> t_check_tag_coverage;
 
 #ifdef GA_RECORD_STATS
    /*
@@ -209,6 +209,40 @@ public:
          std::shared_ptr<hier::PatchLevel>(),
       const bool allocate_data = true) = 0;
 
+   /**
+    * Begin initializing data on a new level, leaving the data transfer
+    * to be completed by finalizeLevelDataInitialization().  The
+    * arguments are those of initializeLevelData().  Between the two
+    * calls, the data on the new level and on the old level must not be
+    * accessed.
+    *
+    * It is virtual with a default implementation that calls
+    * initializeLevelData() so that users are not required to provide an
+    * implementation when the split-phase capability is not needed.
+    *
+    * @see TagAndInitializeStrategy::beginLevelDataInitialization()
+    */
+   virtual void
+   beginLevelDataInitialization(
+      const std::shared_ptr<hier::PatchHierarchy>& hierarchy,
+      const int level_number,
+      const double init_data_time,
+      const bool can_be_refined,
+      const bool initial_time,
+      const std::shared_ptr<hier::PatchLevel>& old_level =
+         std::shared_ptr<hier::PatchLevel>(),
+      const bool allocate_data = true);
+
+   /**
+    * Complete the data initialization started by
+    * beginLevelDataInitialization().  The default implementation does
+    * nothing.
+    */
+   virtual void
+   finalizeLevelDataInitialization(
+      const std::shared_ptr<hier::PatchHierarchy>& hierarchy,
+      const int level_number);
+
    /**
     * After hierarchy levels have changed and data has been initialized on
     * the new levels, this routine can be used to reset any information
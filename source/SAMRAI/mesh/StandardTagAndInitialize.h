@@ -305,6 +305,39 @@ public:
          std::shared_ptr<hier::PatchLevel>(),
       const bool allocate_data = true);
 
+   /*!
+    * Pass the request to begin a split-phase initialization of data on
+    * a new level to the StandardTagAndInitStrategy data member.  See
+    * TagAndInitializeStrategy::beginLevelDataInitialization().
+    *
+    * @pre hierarchy
+    * @pre (level_number >= 0) &&
+    *      (level_number <= hierarchy->getFinestLevelNumber())
+    * @pre !old_level || (level_number == old_level->getLevelNumber())
+    * @pre hierarchy->getPatchLevel(level_number)
+    */
+   void
+   beginLevelDataInitialization(
+      const std::shared_ptr<hier::PatchHierarchy>& hierarchy,
+      const int level_number,
+      const double init_data_time,
+      const bool can_be_refined,
+      const bool initial_time,
+      const std::shared_ptr<hier::PatchLevel>& old_level =
+         std::shared_ptr<hier::PatchLevel>(),
+      const bool allocate_data = true);
+
+   /*!
+    * Pass the request to complete a split-phase initialization of data
+    * on a new level to the StandardTagAndInitStrategy data member.
+    *
+    * @pre hierarchy
+    */
+   void
+   finalizeLevelDataInitialization(
+      const std::shared_ptr<hier::PatchHierarchy>& hierarchy,
+      const int level_number);
+
    /*!
     * Pass the request to reset information that depends on the hierarchy
     * configuration to the StandardTagAndInitStrategy data member.
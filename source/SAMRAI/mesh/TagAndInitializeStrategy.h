@@ -127,6 +127,44 @@ public:
          std::shared_ptr<hier::PatchLevel>(),
       const bool allocate_data = true) = 0;
 
+   /*!
+    * @brief Begin initializing data on a new level, allowing the data
+    * transfer to complete later in finalizeLevelDataInitialization().
+    *
+    * The arguments are the same as for initializeLevelData().  The
+    * gridding algorithm uses this pair of methods when it pipelines
+    * the regridding of multiple levels, doing other regrid work
+    * between the two calls.  Between the calls, the data on the new
+    * level and on old_level must not be accessed.  The gridding
+    * algorithm calls finalizeLevelDataInitialization() before it
+    * changes the hierarchy at level_number-1 or finer.
+    *
+    * The default implementation simply calls initializeLevelData(),
+    * so implementations without a split-phase capability need not do
+    * anything.
+    */
+   virtual void
+   beginLevelDataInitialization(
+      const std::shared_ptr<hier::PatchHierarchy>& hierarchy,
+      const int level_number,
+      const double init_data_time,
+      const bool can_be_refined,
+      const bool initial_time,
+      const std::shared_ptr<hier::PatchLevel>& old_level =
+         std::shared_ptr<hier::PatchLevel>(),
+      const bool allocate_data = true);
+
+   /*!
+    * @brief Complete the data initialization started by
+    * beginLevelDataInitialization().
+    *
+    * The default implementation does nothing.
+    */
+   virtual void
+   finalizeLevelDataInitialization(
+      const std::shared_ptr<hier::PatchHierarchy>& hierarchy,
+      const int level_number);
+
    /*!
     * After hierarchy levels have changed and data has been initialized on
     * the new levels, this routine can be used to reset any information
@@ -68,6 +68,19 @@ namespace mesh {
  *   multiple cycles.  It alleviates the bottle-neck of one process having
  *   to work with too many other processes in any cycle.
  *
+ *   - \b node_aware
+ *   Balance in two levels when the processes run on several
+ *   shared-memory nodes.  Work is first balanced between nodes, each
+ *   process exchanging work only with the processes at the same
+ *   position in the other nodes, and then balanced among the
+ *   processes within each node.  No process gathers the work of its
+ *   node, and the box cuts of the second level stay inside the nodes.
+ *   The node layout is detected at run time.  It must consist of
+ *   equally sized nodes holding contiguous ranges of ranks; otherwise
+ *   a warning is logged and the usual single-level balancing is used.
+ *   Node-aware balancing is not used when balancing within a
+ *   user-given RankGroup.
+ *
  * <b> Details: </b> <br>
  * <table>
  *   <tr>
@@ -102,6 +115,14 @@ namespace mesh {
  *     <td>opt</td>
  *     <td>Not written to restart. Value in input db used.</td>
  *   </tr>
+ *   <tr>
+ *     <td>node_aware</td>
+ *     <td>bool</td>
+ *     <td>FALSE</td>
+ *     <td>TRUE, FALSE</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart. Value in input db used.</td>
+ *   </tr>
  * </table>
  *
  * @internal The following are developer inputs.  Defaults listed
@@ -116,6 +137,12 @@ namespace mesh {
  * Whether to allow box-breaking.  Set to false when boxes have
  * been pre-cut.
  *
+ * @internal DEV_ranks_per_node (0)
+ * int
+ * If positive, use this many ranks per node for node-aware balancing
+ * instead of detecting the node layout.  Useful for testing node-aware
+ * balancing on a single node.
+ *
  * @see LoadBalanceStrategy
  */
 
@@ -638,6 +665,35 @@ private:
       const tbox::RankGroup& rank_group,
       const double group_sum_load) const;
 
+   /*!
+    * @brief Determine the number of ranks per shared-memory node for
+    * node-aware balancing.
+    *
+    * Returns zero if node-aware balancing cannot be used, which is
+    * the case if there is only one node, only one rank per node, or
+    * if the nodes are not equally sized with contiguous ranks.
+    */
+   int
+   computeRanksPerNode() const;
+
+   /*!
+    * @brief Balance in two levels: first between nodes, among the
+    * ranks having the same position in their nodes, then within each
+    * node.
+    *
+    * @param[in,out] balance_box_level
+    * @param[in,out] balance_to_reference
+    * @param[in] ranks_per_node  Number of contiguous ranks per node.
+    *
+    * @pre ranks_per_node > 1
+    * @pre d_mpi.getSize() % ranks_per_node == 0
+    */
+   void
+   loadBalanceAcrossNodes(
+      hier::BoxLevel& balance_box_level,
+      hier::Connector* balance_to_reference,
+      const int ranks_per_node) const;
+
    /*!
     * @brief Distribute load across the rank group using the tree
     * algorithm.
@@ -749,6 +805,12 @@ private:
    //! @brief Whether to allow box breaking.
    bool d_allow_box_breaking;
 
+   //! @brief See "node_aware" input parameter.
+   bool d_node_aware;
+
+   //! @brief See "DEV_ranks_per_node" developer input parameter.
+   int d_ranks_per_node;
+
    //! @brief How to arange a contiguous range of MPI ranks in a tree.
    const std::shared_ptr<tbox::RankTreeStrategy> d_rank_tree;
 
@@ -824,6 +886,8 @@ private:
    std::shared_ptr<tbox::Timer> t_post_load_distribution_barrier;
    std::shared_ptr<tbox::Timer> t_assign_to_local_and_populate_maps;
    std::shared_ptr<tbox::Timer> t_report_loads;
+   std::shared_ptr<tbox::Timer> t_balance_across_nodes;
+   std::shared_ptr<tbox::Timer> t_balance_within_nodes;
    std::shared_ptr<tbox::Timer> t_local_load_moves;
    std::shared_ptr<tbox::Timer> t_finish_sends;
    std::shared_ptr<tbox::Timer> t_barrier_before;
@@ -42,6 +42,7 @@
 #include "SAMRAI/hier/Box.h"
 #include "SAMRAI/hier/VariableContext.h"
 #include "SAMRAI/tbox/Database.h"
+#include "SAMRAI/tbox/SAMRAI_MPI.h"
 #include "SAMRAI/tbox/Timer.h"
 #include "SAMRAI/tbox/Utilities.h"
 
@@ -75,7 +76,10 @@ namespace solv {
  * This class provides:
  * -# 5-point (second order), cell-centered stencil operations
  *    for the discrete Laplacian.
- * -# Red-black Gauss-Seidel smoothing.
+ * -# Red-black Gauss-Seidel smoothing, computed either through a
+ *    side-centered flux temporary or by a fused kernel applying the
+ *    stencil directly to the cell data.
+ * -# Jacobi-preconditioned Chebyshev polynomial smoothing.
  * -# Provisions for working Robin boundary conditions
  *    (see RobinBcCoefStrategy).
  *
@@ -107,15 +111,52 @@ namespace solv {
  *
  * <b> Definitions: </b>
  *    - \b    coarse_solver_choice
+ *       Solver for the coarsest level.  "redblack" and "jacobi" both
+ *       iterate the error smoother selected by smoothing_choice.  "cg"
+ *       runs conjugate gradient iterations, which need far fewer
+ *       iterations than smoothing when the coarsest level is large.
+ *       "hypre" requires SAMRAI to be configured with hypre.
  *
  *    - \b    coarse_solver_tolerance
  *
  *    - \b    coarse_solver_max_iterations
  *
+ *    - \b    coarse_agglomeration_threshold
+ *       When the coarsest level has fewer cells per process than this,
+ *       the "cg" coarse solver gathers it onto
+ *       coarse_agglomeration_num_ranks processes, iterates there and
+ *       scatters the correction back.  This trades two transfers per
+ *       coarse solve for the many small ghost exchanges and global
+ *       reductions of the iteration.  Zero disables agglomeration.
+ *       A positive value requires coarse_solver_choice = "cg".
+ *
+ *    - \b    coarse_agglomeration_num_ranks
+ *       Number of processes holding the agglomerated coarsest level.
+ *
  *    - \b    cf_discretization
  *
  *    - \b    prolongation_method
  *
+ *    - \b    smoothing_choice
+ *       Error smoother.  "redblack" is red-black Gauss-Seidel computing
+ *       the side-centered flux before each half sweep.  "fused_redblack"
+ *       gives the same iteration but applies the stencil directly to the
+ *       cell data, avoiding the flux temporary except on patches touching
+ *       a coarse-fine boundary with the "Ewing" discretization.
+ *       "chebyshev" applies a Jacobi-preconditioned Chebyshev polynomial
+ *       per sweep, which has no ordering dependence between cells.
+ *       Patch loops of the fused smoothers are threaded when SAMRAI is
+ *       built with OpenMP.
+ *
+ *    - \b    chebyshev_degree
+ *       Polynomial degree of each Chebyshev sweep.  Each degree costs one
+ *       ghost cell exchange.
+ *
+ *    - \b    chebyshev_eig_ratio
+ *       Ratio of the largest to the smallest eigenvalue targeted by the
+ *       Chebyshev smoother.  The largest eigenvalue of the diagonally
+ *       scaled operator is bounded by 2.
+ *
  *    - \b    enable_logging
  *
  * <b> Details:</b> <br>
@@ -132,7 +173,7 @@ namespace solv {
  *     <td>coarse_solver_choice</td>
  *     <td>string</td>
  *     <td>"hypre"</td>
- *     <td>"hypre", "redblack", "jacobi"</td>
+ *     <td>"hypre", "redblack", "jacobi", "cg"</td>
  *     <td>opt</td>
  *     <td>Not written to restart.  Value in input db used.</td>
  *   </tr>
@@ -153,6 +194,22 @@ namespace solv {
  *     <td>Not written to restart.  Value in input db used.</td>
  *   </tr>
  *   <tr>
+ *     <td>coarse_agglomeration_threshold</td>
+ *     <td>int</td>
+ *     <td>0</td>
+ *     <td>>=0</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>coarse_agglomeration_num_ranks</td>
+ *     <td>int</td>
+ *     <td>1</td>
+ *     <td>>=1</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
  *     <td>cf_discretization</td>
  *     <td>string</td>
  *     <td>"Ewing"</td>
@@ -169,6 +226,30 @@ namespace solv {
  *     <td>Not written to restart.  Value in input db used.</td>
  *   </tr>
  *   <tr>
+ *     <td>smoothing_choice</td>
+ *     <td>string</td>
+ *     <td>"redblack"</td>
+ *     <td>"redblack", "fused_redblack", "chebyshev"</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>chebyshev_degree</td>
+ *     <td>int</td>
+ *     <td>2</td>
+ *     <td>>=1</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>chebyshev_eig_ratio</td>
+ *     <td>double</td>
+ *     <td>2*dim</td>
+ *     <td>>1.0</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
  *     <td>enable_logging</td>
  *     <td>bool</td>
  *     <td>FALSE</td>
@@ -233,6 +314,7 @@ public:
       const PoissonSpecifications& spec)
    {
       d_poisson_spec = spec;
+      d_agglomerated_error_id = -1;
    }
 
    //@{
@@ -522,6 +604,117 @@ private:
       int num_sweeps,
       double residual_tolerance = -1.0);
 
+   /*!
+    * @brief Chebyshev polynomial error smoothing on a level.
+    *
+    * Smoothes on the residual equation @f$ Ae=r @f$ on a level, using
+    * a polynomial of degree d_chebyshev_degree in the diagonally
+    * preconditioned operator per sweep.
+    *
+    * @param error error vector
+    * @param residual residual vector
+    * @param ln level number
+    * @param num_sweeps number of sweeps
+    * @param residual_tolerance the maximum residual considered to be
+    *        converged
+    *
+    * @pre data.getPatchHierarchy() == d_hierarchy &&
+    *      residual.getPatchHierarchy() == d_hierarchy
+    */
+   void
+   smoothErrorByChebyshev(
+      SAMRAIVectorReal<double>& error,
+      const SAMRAIVectorReal<double>& residual,
+      int ln,
+      int num_sweeps,
+      double residual_tolerance = -1.0);
+
+   /*!
+    * @brief Red or black half sweep over all patches of a level.
+    *
+    * Ghost cells of the error must be current.  Patches use the fused
+    * kernel if it is selected and the patch does not need the flux
+    * (see needsFluxForSmoothing()).
+    *
+    * @param level level to smooth
+    * @param error error vector
+    * @param residual residual vector
+    * @param red_or_black red-black switch.  Set to 'r' or 'b'.
+    * @param p_maxres max residual output.
+    */
+   void
+   redOrBlackSmoothingOnLevel(
+      const hier::PatchLevel& level,
+      SAMRAIVectorReal<double>& error,
+      const SAMRAIVectorReal<double>& residual,
+      char red_or_black,
+      double* p_maxres);
+
+   /*!
+    * @brief Whether smoothing on a patch must go through the
+    * side-centered flux.
+    *
+    * This is the case on patches touching a coarse-fine boundary when
+    * the "Ewing" coarse-fine discretization corrects the flux there.
+    */
+   bool
+   needsFluxForSmoothing(
+      const hier::Patch& patch) const;
+
+   /*!
+    * @brief Build the agglomerated copy of the coarsest level if
+    * agglomeration is enabled and worthwhile.
+    *
+    * Sets d_agglomerated_level, its overlap Connectors and the
+    * communicator of the processes owning it.
+    */
+   void
+   initializeAgglomeratedLevel();
+
+   /*!
+    * @brief Solve the coarsest level on the agglomerated level.
+    *
+    * Gathers the error, residual and variable coefficients to
+    * d_agglomerated_level, solves there with solveByConjugateGradient()
+    * and scatters the error back.
+    *
+    * @return 0 if converged.  Processes not owning the agglomerated
+    * level always return 0.
+    *
+    * @pre d_agglomerated_level
+    */
+   int
+   solveCoarsestLevelAgglomerated(
+      SAMRAIVectorReal<double>& error,
+      const SAMRAIVectorReal<double>& residual);
+
+   /*!
+    * @brief Solve Ae=r on a coarsest level with conjugate gradient
+    * iterations.
+    *
+    * Iterates until the max norm of the residual is within
+    * d_coarse_solver_tolerance or d_coarse_solver_max_iterations is
+    * reached.  The search direction is held in d_cell_scratch_id,
+    * which must be allocated on the level.
+    *
+    * @param level The coarsest level or its agglomerated copy.
+    * @param error_id Initial guess on input, solution on output.
+    * @param rhs_id Right-hand side r.
+    * @param ghostfill_schedule Schedule filling the ghosts of
+    *        d_cell_scratch_id on level.  If null, the schedule of the
+    *        coarsest hierarchy level is used.
+    * @param mpi Processes owning level, for the reductions.
+    *
+    * @return 0 if converged.
+    */
+   int
+   solveByConjugateGradient(
+      const hier::PatchLevel& level,
+      int error_id,
+      int rhs_id,
+      const std::shared_ptr<xfer::RefineSchedule>& ghostfill_schedule,
+      const tbox::SAMRAI_MPI& mpi);
+
    /*!
     * @brief Solve the coarsest level using HYPRE
     */
@@ -605,6 +798,79 @@ private:
       char red_or_black,
       double* p_maxres = 0) const;
 
+   /*!
+    * @brief AMR-unaware function to red or black smoothing on a single
+    * patch, applying the stencil directly to the solution.
+    *
+    * Gives the same iteration as redOrBlackSmoothingOnPatch() with the
+    * flux from computeFluxOnPatch(), except that no Ewing flux
+    * correction is applied.
+    *
+    * @param patch patch
+    * @param rhs_data cell-centered rhs data
+    * @param soln_data cell-centered solution data
+    * @param red_or_black red-black switch.  Set to 'r' or 'b'.
+    * @param p_maxres max residual output.  Set to NULL to avoid computing.
+    *
+    * @pre (d_dim == patch.getDim()) && (d_dim == soln_data.getDim()) &&
+    *      (d_dim == rhs_data.getDim())
+    * @pre (red_or_black == 'r') || (red_or_black == 'b')
+    */
+   void
+   fusedRedOrBlackSmoothingOnPatch(
+      const hier::Patch& patch,
+      const pdat::CellData<double>& rhs_data,
+      pdat::CellData<double>& soln_data,
+      char red_or_black,
+      double* p_maxres = 0) const;
+
+   /*!
+    * @brief AMR-unaware function to compute residual on a single patch
+    * directly from the solution, without Ewing flux correction.
+    *
+    * @param patch patch
+    * @param soln_data cell-centered solution data
+    * @param rhs_data cell-centered rhs data
+    * @param residual_data cell-centered residual data
+    *
+    * @pre (d_dim == patch.getDim()) && (d_dim == soln_data.getDim()) &&
+    *      (d_dim == rhs_data.getDim()) && (d_dim == residual_data.getDim())
+    */
+   void
+   computeFusedResidualOnPatch(
+      const hier::Patch& patch,
+      const pdat::CellData<double>& soln_data,
+      const pdat::CellData<double>& rhs_data,
+      pdat::CellData<double>& residual_data) const;
+
+   /*!
+    * @brief AMR-unaware function to take one Chebyshev step on a single
+    * patch.
+    *
+    * Sets dir = alpha*dir + beta*residual/diagonal and adds dir to the
+    * solution.
+    *
+    * @param patch patch
+    * @param residual_data cell-centered residual of the current solution
+    * @param soln_data cell-centered solution data
+    * @param dir_data cell-centered search direction
+    * @param alpha weight of the previous direction
+    * @param beta weight of the scaled residual
+    * @param p_maxres max residual output.
+    *
+    * @pre (d_dim == patch.getDim()) && (d_dim == soln_data.getDim()) &&
+    *      (d_dim == residual_data.getDim()) && (d_dim == dir_data.getDim())
+    */
+   void
+   chebyshevUpdateOnPatch(
+      const hier::Patch& patch,
+      const pdat::CellData<double>& residual_data,
+      pdat::CellData<double>& soln_data,
+      pdat::CellData<double>& dir_data,
+      double alpha,
+      double beta,
+      double* p_maxres) const;
+
    //@}
 
    //@{ @name For executing, caching and resetting communication schedules.
@@ -852,6 +1118,22 @@ private:
     */
    std::string d_prolongation_method;
 
+   /*!
+    * @brief Error smoother.
+    */
+   std::string d_smoothing_choice;
+
+   /*!
+    * @brief Polynomial degree of a Chebyshev smoothing sweep.
+    */
+   int d_chebyshev_degree;
+
+   /*!
+    * @brief Ratio of largest to smallest eigenvalue targeted by the
+    * Chebyshev smoother.
+    */
+   double d_chebyshev_eig_ratio;
+
    /*!
     * @brief Tolerance specified to coarse solver
     */
@@ -862,6 +1144,17 @@ private:
     */
    int d_coarse_solver_max_iterations;
 
+   /*!
+    * @brief Cells per process on the coarsest level below which it is
+    * agglomerated.  Zero disables agglomeration.
+    */
+   int d_coarse_agglomeration_threshold;
+
+   /*!
+    * @brief Number of processes holding the agglomerated coarsest level.
+    */
+   int d_coarse_agglomeration_num_ranks;
+
    /*!
     * @brief Residual tolerance to govern smoothing.
     *
@@ -998,6 +1291,36 @@ private:
 
    //@}
 
+   //@{
+   /*!
+    * @name Agglomerated coarsest level.
+    *
+    * d_agglomerated_level is null unless agglomeration is in effect.
+    * The schedules are built for the patch data indices recorded in
+    * d_agglomerated_error_id and d_agglomerated_residual_id and rebuilt
+    * when the coarse solve is called with other indices or the Poisson
+    * specifications change.
+    */
+
+   std::shared_ptr<hier::PatchLevel> d_agglomerated_level;
+
+   //! @brief Processes 0 to d_agglomerated_num_ranks-1 own the level.
+   int d_agglomerated_num_ranks;
+
+   /*!
+    * @brief Communicator of the processes owning d_agglomerated_level,
+    * used for the convergence test of the agglomerated solve.
+    */
+   tbox::SAMRAI_MPI d_agglomerated_mpi;
+
+   std::shared_ptr<xfer::RefineSchedule> d_agglomerate_gather_schedule;
+   std::shared_ptr<xfer::RefineSchedule> d_agglomerate_scatter_schedule;
+   std::shared_ptr<xfer::RefineSchedule> d_agglomerate_ghostfill_schedule;
+   int d_agglomerated_error_id;
+   int d_agglomerated_residual_id;
+
+   //@}
+
    /*!
     * @brief Utility object employed in setting ghost cells and providing
     * xfer::RefinePatchStrategy implementation.
@@ -1056,6 +1379,7 @@ private:
    std::shared_ptr<tbox::Timer> t_prolong;
    std::shared_ptr<tbox::Timer> t_smooth_error;
    std::shared_ptr<tbox::Timer> t_solve_coarsest;
+   std::shared_ptr<tbox::Timer> t_agglomerate_coarsest;
    std::shared_ptr<tbox::Timer> t_compute_composite_residual;
    std::shared_ptr<tbox::Timer> t_compute_residual_norm;
 
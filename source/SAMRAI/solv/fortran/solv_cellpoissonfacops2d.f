@@ -685,3 +685,355 @@ c        max j edge
       return
       end
 c***********************************************************************
+c***********************************************************************
+c Red-black Gauss-Seidel sweep applying the variable-coefficient
+c 5-point stencil directly to soln, without a side-centered flux
+c temporary.  scalar_field is referenced only if sfvar is 1,
+c otherwise the constant sfconst is used.
+c***********************************************************************
+      subroutine rbgsfusedvardc2d(
+     &xdc , ydc , dcgi, dcgj ,
+     &rhs , rhsgi, rhsgj ,
+     &scalar_field , sfgi, sfgj , sfconst , sfvar ,
+     &soln , solngi, solngj ,
+     &ifirst, ilast, jfirst, jlast ,
+     &dx ,
+     &offset, maxres )
+
+      implicit none
+      integer ifirst, ilast, jfirst, jlast
+      integer dcgi, dcgj, rhsgi, rhsgj,
+     &        solngi, solngj, sfgi, sfgj, sfvar
+      double precision xdc(ifirst-dcgi:ilast+1+dcgi,
+     &                     jfirst-dcgj:jlast+dcgj)
+      double precision ydc(ifirst-dcgi:ilast+dcgi,
+     &                     jfirst-dcgj:jlast+1+dcgj)
+      double precision soln(ifirst-solngi:ilast+solngi,
+     &                      jfirst-solngj:jlast+solngj)
+      double precision rhs(ifirst-rhsgi:ilast+rhsgi,
+     &                     jfirst-rhsgj:jlast+rhsgj)
+      double precision scalar_field(ifirst-sfgi:ilast+sfgi,
+     &                              jfirst-sfgj:jlast+sfgj)
+      double precision sfconst
+      double precision dx(0:1)
+      integer offset
+      double precision maxres
+
+      double precision residual, du
+      double precision dxi, dyi
+      double precision dudr, sf
+      integer i, j
+      integer ioffset
+
+      dxi = 1./dx(0)
+      dyi = 1./dx(1)
+
+      maxres = 0.0
+      sf = sfconst
+
+      do j=jfirst,jlast
+c        offset must be 0 (red) or 1 (black)
+         if ( (jfirst+j)-((jfirst+j)/2*2) .ne. offset ) then
+            ioffset = 1
+         else
+            ioffset = 0
+         endif
+         do i=ifirst+ioffset,ilast,2
+            if ( sfvar .eq. 1 ) sf = scalar_field(i,j)
+            residual
+     &         = rhs(i,j)
+     &         - ( dxi*( dxi*xdc(i+1,j)*( soln(i+1,j) - soln(i,j) )
+     &                 - dxi*xdc(i,j)*( soln(i,j) - soln(i-1,j) ) )
+     &           + dyi*( dyi*ydc(i,j+1)*( soln(i,j+1) - soln(i,j) )
+     &                 - dyi*ydc(i,j)*( soln(i,j) - soln(i,j-1) ) ) )
+     &         - sf*soln(i,j)
+            dudr = 1./( ( dxi*dxi*( xdc(i+1,j) + xdc(i,j) )
+     &                  + dyi*dyi*( ydc(i,j+1) + ydc(i,j) ) )
+     &                  - sf )
+            du = -residual*dudr
+            soln(i,j) = soln(i,j) + du
+            if ( maxres .lt. abs(residual) ) maxres = abs(residual)
+         enddo
+      enddo
+      return
+      end
+c***********************************************************************
+c***********************************************************************
+      subroutine rbgsfusedcondc2d(
+     &dc ,
+     &rhs , rhsgi, rhsgj ,
+     &scalar_field , sfgi, sfgj , sfconst , sfvar ,
+     &soln , solngi, solngj ,
+     &ifirst, ilast, jfirst, jlast ,
+     &dx ,
+     &offset, maxres )
+
+      implicit none
+      integer ifirst, ilast, jfirst, jlast
+      integer rhsgi, rhsgj,
+     &        solngi, solngj, sfgi, sfgj, sfvar
+      double precision dc
+      double precision soln(ifirst-solngi:ilast+solngi,
+     &                      jfirst-solngj:jlast+solngj)
+      double precision rhs(ifirst-rhsgi:ilast+rhsgi,
+     &                     jfirst-rhsgj:jlast+rhsgj)
+      double precision scalar_field(ifirst-sfgi:ilast+sfgi,
+     &                              jfirst-sfgj:jlast+sfgj)
+      double precision sfconst
+      double precision dx(0:1)
+      integer offset
+      double precision maxres
+
+      double precision residual, du
+      double precision dxi, dyi
+      double precision dudr, sf
+      integer i, j
+      integer ioffset
+
+      dxi = 1./dx(0)
+      dyi = 1./dx(1)
+
+      maxres = 0.0
+      sf = sfconst
+
+      do j=jfirst,jlast
+c        offset must be 0 (red) or 1 (black)
+         if ( (jfirst+j)-((jfirst+j)/2*2) .ne. offset ) then
+            ioffset = 1
+         else
+            ioffset = 0
+         endif
+         do i=ifirst+ioffset,ilast,2
+            if ( sfvar .eq. 1 ) sf = scalar_field(i,j)
+            residual
+     &         = rhs(i,j)
+     &         - ( dxi*( dxi*dc*( soln(i+1,j) - soln(i,j) )
+     &                 - dxi*dc*( soln(i,j) - soln(i-1,j) ) )
+     &           + dyi*( dyi*dc*( soln(i,j+1) - soln(i,j) )
+     &                 - dyi*dc*( soln(i,j) - soln(i,j-1) ) ) )
+     &         - sf*soln(i,j)
+            dudr = 1./( ( dxi*dxi*( dc + dc )
+     &                  + dyi*dyi*( dc + dc ) )
+     &                  - sf )
+            du = -residual*dudr
+            soln(i,j) = soln(i,j) + du
+            if ( maxres .lt. abs(residual) ) maxres = abs(residual)
+         enddo
+      enddo
+      return
+      end
+c***********************************************************************
+c Residual of the variable-coefficient 5-point stencil computed
+c directly from soln, without a side-centered flux temporary.
+c***********************************************************************
+      subroutine compresfusedvardc2d(
+     &xdc , ydc , dcgi, dcgj ,
+     &rhs , rhsgi, rhsgj ,
+     &residual , residualgi, residualgj ,
+     &scalar_field , sfgi, sfgj , sfconst , sfvar ,
+     &soln , solngi, solngj ,
+     &ifirst, ilast, jfirst, jlast ,
+     &dx )
+
+      implicit none
+      integer ifirst, ilast, jfirst, jlast
+      integer dcgi, dcgj, rhsgi, rhsgj, residualgi, residualgj,
+     &        solngi, solngj, sfgi, sfgj, sfvar
+      double precision xdc(ifirst-dcgi:ilast+1+dcgi,
+     &                     jfirst-dcgj:jlast+dcgj)
+      double precision ydc(ifirst-dcgi:ilast+dcgi,
+     &                     jfirst-dcgj:jlast+1+dcgj)
+      double precision soln(ifirst-solngi:ilast+solngi,
+     &                      jfirst-solngj:jlast+solngj)
+      double precision rhs(ifirst-rhsgi:ilast+rhsgi,
+     &                     jfirst-rhsgj:jlast+rhsgj)
+      double precision residual(ifirst-residualgi:ilast+residualgi,
+     &                          jfirst-residualgj:jlast+residualgj)
+      double precision scalar_field(ifirst-sfgi:ilast+sfgi,
+     &                              jfirst-sfgj:jlast+sfgj)
+      double precision sfconst
+      double precision dx(0:1)
+
+      double precision dxi, dyi, sf
+      integer i, j
+
+      dxi = 1./dx(0)
+      dyi = 1./dx(1)
+      sf = sfconst
+
+      do j=jfirst,jlast
+         do i=ifirst,ilast
+            if ( sfvar .eq. 1 ) sf = scalar_field(i,j)
+            residual(i,j)
+     &         = rhs(i,j)
+     &         - ( dxi*( dxi*xdc(i+1,j)*( soln(i+1,j) - soln(i,j) )
+     &                 - dxi*xdc(i,j)*( soln(i,j) - soln(i-1,j) ) )
+     &           + dyi*( dyi*ydc(i,j+1)*( soln(i,j+1) - soln(i,j) )
+     &                 - dyi*ydc(i,j)*( soln(i,j) - soln(i,j-1) ) ) )
+     &         - sf*soln(i,j)
+         enddo
+      enddo
+      return
+      end
+c***********************************************************************
+c***********************************************************************
+      subroutine compresfusedcondc2d(
+     &dc ,
+     &rhs , rhsgi, rhsgj ,
+     &residual , residualgi, residualgj ,
+     &scalar_field , sfgi, sfgj , sfconst , sfvar ,
+     &soln , solngi, solngj ,
+     &ifirst, ilast, jfirst, jlast ,
+     &dx )
+
+      implicit none
+      integer ifirst, ilast, jfirst, jlast
+      integer rhsgi, rhsgj, residualgi, residualgj,
+     &        solngi, solngj, sfgi, sfgj, sfvar
+      double precision dc
+      double precision soln(ifirst-solngi:ilast+solngi,
+     &                      jfirst-solngj:jlast+solngj)
+      double precision rhs(ifirst-rhsgi:ilast+rhsgi,
+     &                     jfirst-rhsgj:jlast+rhsgj)
+      double precision residual(ifirst-residualgi:ilast+residualgi,
+     &                          jfirst-residualgj:jlast+residualgj)
+      double precision scalar_field(ifirst-sfgi:ilast+sfgi,
+     &                              jfirst-sfgj:jlast+sfgj)
+      double precision sfconst
+      double precision dx(0:1)
+
+      double precision dxi, dyi, sf
+      integer i, j
+
+      dxi = 1./dx(0)
+      dyi = 1./dx(1)
+      sf = sfconst
+
+      do j=jfirst,jlast
+         do i=ifirst,ilast
+            if ( sfvar .eq. 1 ) sf = scalar_field(i,j)
+            residual(i,j)
+     &         = rhs(i,j)
+     &         - ( dxi*( dxi*dc*( soln(i+1,j) - soln(i,j) )
+     &                 - dxi*dc*( soln(i,j) - soln(i-1,j) ) )
+     &           + dyi*( dyi*dc*( soln(i,j+1) - soln(i,j) )
+     &                 - dyi*dc*( soln(i,j) - soln(i,j-1) ) ) )
+     &         - sf*soln(i,j)
+         enddo
+      enddo
+      return
+      end
+c***********************************************************************
+c One step of the Jacobi-preconditioned Chebyshev iteration:
+c dir = alpha*dir + beta*(residual/diagonal), soln = soln + dir.
+c***********************************************************************
+      subroutine chebyupdatevardc2d(
+     &xdc , ydc , dcgi, dcgj ,
+     &residual , residualgi, residualgj ,
+     &scalar_field , sfgi, sfgj , sfconst , sfvar ,
+     &soln , solngi, solngj ,
+     &dir , dirgi, dirgj ,
+     &ifirst, ilast, jfirst, jlast ,
+     &dx ,
+     &alpha, beta, maxres )
+
+      implicit none
+      integer ifirst, ilast, jfirst, jlast
+      integer dcgi, dcgj, residualgi, residualgj,
+     &        solngi, solngj, sfgi, sfgj, sfvar, dirgi, dirgj
+      double precision xdc(ifirst-dcgi:ilast+1+dcgi,
+     &                     jfirst-dcgj:jlast+dcgj)
+      double precision ydc(ifirst-dcgi:ilast+dcgi,
+     &                     jfirst-dcgj:jlast+1+dcgj)
+      double precision soln(ifirst-solngi:ilast+solngi,
+     &                      jfirst-solngj:jlast+solngj)
+      double precision residual(ifirst-residualgi:ilast+residualgi,
+     &                          jfirst-residualgj:jlast+residualgj)
+      double precision scalar_field(ifirst-sfgi:ilast+sfgi,
+     &                              jfirst-sfgj:jlast+sfgj)
+      double precision dir(ifirst-dirgi:ilast+dirgi,
+     &                     jfirst-dirgj:jlast+dirgj)
+      double precision sfconst
+      double precision dx(0:1)
+      double precision alpha, beta
+      double precision maxres
+
+      double precision dxi, dyi
+      double precision dudr, sf
+      integer i, j
+
+      dxi = 1./dx(0)
+      dyi = 1./dx(1)
+
+      maxres = 0.0
+      sf = sfconst
+
+      do j=jfirst,jlast
+         do i=ifirst,ilast
+            if ( sfvar .eq. 1 ) sf = scalar_field(i,j)
+            dudr = 1./( ( dxi*dxi*( xdc(i+1,j) + xdc(i,j) )
+     &                  + dyi*dyi*( ydc(i,j+1) + ydc(i,j) ) )
+     &                  - sf )
+            dir(i,j) = alpha*dir(i,j) - beta*residual(i,j)*dudr
+            soln(i,j) = soln(i,j) + dir(i,j)
+            if ( maxres .lt. abs(residual(i,j)) )
+     &         maxres = abs(residual(i,j))
+         enddo
+      enddo
+      return
+      end
+c***********************************************************************
+c***********************************************************************
+      subroutine chebyupdatecondc2d(
+     &dc ,
+     &residual , residualgi, residualgj ,
+     &scalar_field , sfgi, sfgj , sfconst , sfvar ,
+     &soln , solngi, solngj ,
+     &dir , dirgi, dirgj ,
+     &ifirst, ilast, jfirst, jlast ,
+     &dx ,
+     &alpha, beta, maxres )
+
+      implicit none
+      integer ifirst, ilast, jfirst, jlast
+      integer residualgi, residualgj,
+     &        solngi, solngj, sfgi, sfgj, sfvar, dirgi, dirgj
+      double precision dc
+      double precision soln(ifirst-solngi:ilast+solngi,
+     &                      jfirst-solngj:jlast+solngj)
+      double precision residual(ifirst-residualgi:ilast+residualgi,
+     &                          jfirst-residualgj:jlast+residualgj)
+      double precision scalar_field(ifirst-sfgi:ilast+sfgi,
+     &                              jfirst-sfgj:jlast+sfgj)
+      double precision dir(ifirst-dirgi:ilast+dirgi,
+     &                     jfirst-dirgj:jlast+dirgj)
+      double precision sfconst
+      double precision dx(0:1)
+      double precision alpha, beta
+      double precision maxres
+
+      double precision dxi, dyi
+      double precision dudr, sf
+      integer i, j
+
+      dxi = 1./dx(0)
+      dyi = 1./dx(1)
+
+      maxres = 0.0
+      sf = sfconst
+
+      do j=jfirst,jlast
+         do i=ifirst,ilast
+            if ( sfvar .eq. 1 ) sf = scalar_field(i,j)
+            dudr = 1./( ( dxi*dxi*( dc + dc )
+     &                  + dyi*dyi*( dc + dc ) )
+     &                  - sf )
+            dir(i,j) = alpha*dir(i,j) - beta*residual(i,j)*dudr
+            soln(i,j) = soln(i,j) + dir(i,j)
+            if ( maxres .lt. abs(residual(i,j)) )
+     &         maxres = abs(residual(i,j))
+         enddo
+      enddo
+      return
+      end
+c***********************************************************************
@@ -1010,3 +1010,438 @@ c        max k face
       return
       end
 c***********************************************************************
+c***********************************************************************
+c Red-black Gauss-Seidel sweep applying the variable-coefficient
+c 7-point stencil directly to soln, without a side-centered flux
+c temporary.  scalar_field is referenced only if sfvar is 1,
+c otherwise the constant sfconst is used.
+c***********************************************************************
+      subroutine rbgsfusedvardc3d(
+     &xdc , ydc , zdc, dcgi, dcgj , dcgk ,
+     &rhs , rhsgi, rhsgj , rhsgk ,
+     &scalar_field , sfgi, sfgj , sfgk , sfconst , sfvar ,
+     &soln , solngi, solngj , solngk ,
+     &ifirst, ilast, jfirst, jlast , kfirst, klast ,
+     &dx ,
+     &offset, maxres )
+
+      implicit none
+      integer ifirst, ilast, jfirst, jlast, kfirst, klast
+      integer dcgi, dcgj, dcgk,
+     &        rhsgi, rhsgj, rhsgk, solngi, solngj, solngk,
+     &        sfgi, sfgj, sfgk, sfvar
+      double precision xdc(ifirst-dcgi:ilast+1+dcgi,
+     &                     jfirst-dcgj:jlast+dcgj,
+     &                     kfirst-dcgk:klast+dcgk)
+      double precision ydc(ifirst-dcgi:ilast+dcgi,
+     &                     jfirst-dcgj:jlast+1+dcgj,
+     &                     kfirst-dcgk:klast+dcgk)
+      double precision zdc(ifirst-dcgi:ilast+dcgi,
+     &                     jfirst-dcgj:jlast+dcgj,
+     &                     kfirst-dcgk:klast+1+dcgk)
+      double precision soln(ifirst-solngi:ilast+solngi,
+     &                      jfirst-solngj:jlast+solngj,
+     &                      kfirst-solngk:klast+solngk)
+      double precision rhs(ifirst-rhsgi:ilast+rhsgi,
+     &                     jfirst-rhsgj:jlast+rhsgj,
+     &                     kfirst-rhsgk:klast+rhsgk)
+      double precision scalar_field(ifirst-sfgi:ilast+sfgi,
+     &                              jfirst-sfgj:jlast+sfgj,
+     &                              kfirst-sfgk:klast+sfgk)
+      double precision sfconst
+      double precision dx(0:2)
+      integer offset
+      double precision maxres
+
+      double precision residual, du
+      double precision dxi, dyi, dzi, dxi2, dyi2, dzi2
+      double precision dudr, sf
+      integer i, j, k
+      integer ioffset
+
+      dxi = 1./dx(0)
+      dyi = 1./dx(1)
+      dzi = 1./dx(2)
+      dxi2 = dxi*dxi
+      dyi2 = dyi*dyi
+      dzi2 = dzi*dzi
+
+      maxres = 0.0
+      sf = sfconst
+
+      do k=kfirst,klast
+      do j=jfirst,jlast
+c        offset must be 0 (red) or 1 (black)
+         if ( (ifirst+j+k)-((ifirst+j+k)/2*2) .ne. offset ) then
+            ioffset = 1
+         else
+            ioffset = 0
+         endif
+         do i=ifirst+ioffset,ilast,2
+             if ( sfvar .eq. 1 ) sf = scalar_field(i,j,k)
+             residual
+     &          = rhs(i,j,k)
+     &          - ( dxi*( dxi*xdc(i+1,j,k)*(soln(i+1,j,k)-soln(i,j,k))
+     &                  - dxi*xdc(i,j,k)*(soln(i,j,k)-soln(i-1,j,k)) )
+     &            + dyi*( dyi*ydc(i,j+1,k)*(soln(i,j+1,k)-soln(i,j,k))
+     &                  - dyi*ydc(i,j,k)*(soln(i,j,k)-soln(i,j-1,k)) )
+     &            + dzi*( dzi*zdc(i,j,k+1)*(soln(i,j,k+1)-soln(i,j,k))
+     &                  - dzi*zdc(i,j,k)*(soln(i,j,k)-soln(i,j,k-1)) ) )
+     &          - sf*soln(i,j,k)
+             dudr = 1./( ( dxi2*( xdc(i+1,j,k)+xdc(i,j,k) )
+     &                   + dyi2*( ydc(i,j+1,k)+ydc(i,j,k) )
+     &                   + dzi2*( zdc(i,j,k+1)+zdc(i,j,k) ) )
+     &                   - sf )
+             du = -residual*dudr
+             soln(i,j,k) = soln(i,j,k) + du
+             if ( maxres .lt. abs(residual) ) maxres = abs(residual)
+         enddo
+      enddo
+      enddo
+      return
+      end
+c***********************************************************************
+c***********************************************************************
+      subroutine rbgsfusedcondc3d(
+     &dc ,
+     &rhs , rhsgi, rhsgj , rhsgk ,
+     &scalar_field , sfgi, sfgj , sfgk , sfconst , sfvar ,
+     &soln , solngi, solngj , solngk ,
+     &ifirst, ilast, jfirst, jlast , kfirst, klast ,
+     &dx ,
+     &offset, maxres )
+
+      implicit none
+      integer ifirst, ilast, jfirst, jlast, kfirst, klast
+      integer rhsgi, rhsgj, rhsgk, solngi, solngj, solngk,
+     &        sfgi, sfgj, sfgk, sfvar
+      double precision dc
+      double precision soln(ifirst-solngi:ilast+solngi,
+     &                      jfirst-solngj:jlast+solngj,
+     &                      kfirst-solngk:klast+solngk)
+      double precision rhs(ifirst-rhsgi:ilast+rhsgi,
+     &                     jfirst-rhsgj:jlast+rhsgj,
+     &                     kfirst-rhsgk:klast+rhsgk)
+      double precision scalar_field(ifirst-sfgi:ilast+sfgi,
+     &                              jfirst-sfgj:jlast+sfgj,
+     &                              kfirst-sfgk:klast+sfgk)
+      double precision sfconst
+      double precision dx(0:2)
+      integer offset
+      double precision maxres
+
+      double precision residual, du
+      double precision dxi, dyi, dzi, dxi2, dyi2, dzi2
+      double precision dudr, sf
+      integer i, j, k
+      integer ioffset
+
+      dxi = 1./dx(0)
+      dyi = 1./dx(1)
+      dzi = 1./dx(2)
+      dxi2 = dxi*dxi
+      dyi2 = dyi*dyi
+      dzi2 = dzi*dzi
+
+      maxres = 0.0
+      sf = sfconst
+
+      do k=kfirst,klast
+      do j=jfirst,jlast
+c        offset must be 0 (red) or 1 (black)
+         if ( (ifirst+j+k)-((ifirst+j+k)/2*2) .ne. offset ) then
+            ioffset = 1
+         else
+            ioffset = 0
+         endif
+         do i=ifirst+ioffset,ilast,2
+             if ( sfvar .eq. 1 ) sf = scalar_field(i,j,k)
+             residual
+     &          = rhs(i,j,k)
+     &          - ( dxi*( dxi*dc*(soln(i+1,j,k)-soln(i,j,k))
+     &                  - dxi*dc*(soln(i,j,k)-soln(i-1,j,k)) )
+     &            + dyi*( dyi*dc*(soln(i,j+1,k)-soln(i,j,k))
+     &                  - dyi*dc*(soln(i,j,k)-soln(i,j-1,k)) )
+     &            + dzi*( dzi*dc*(soln(i,j,k+1)-soln(i,j,k))
+     &                  - dzi*dc*(soln(i,j,k)-soln(i,j,k-1)) ) )
+     &          - sf*soln(i,j,k)
+             dudr = 1./( ( dxi2*( dc + dc )
+     &                   + dyi2*( dc + dc )
+     &                   + dzi2*( dc + dc ) )
+     &                   - sf )
+             du = -residual*dudr
+             soln(i,j,k) = soln(i,j,k) + du
+             if ( maxres .lt. abs(residual) ) maxres = abs(residual)
+         enddo
+      enddo
+      enddo
+      return
+      end
+c***********************************************************************
+c Residual of the variable-coefficient 7-point stencil computed
+c directly from soln, without a side-centered flux temporary.
+c***********************************************************************
+      subroutine compresfusedvardc3d(
+     &xdc , ydc , zdc, dcgi, dcgj , dcgk ,
+     &rhs , rhsgi, rhsgj , rhsgk ,
+     &residual , residualgi, residualgj , residualgk ,
+     &scalar_field , sfgi, sfgj , sfgk , sfconst , sfvar ,
+     &soln , solngi, solngj , solngk ,
+     &ifirst, ilast, jfirst, jlast , kfirst, klast ,
+     &dx )
+
+      implicit none
+      integer ifirst, ilast, jfirst, jlast, kfirst, klast
+      integer dcgi, dcgj, dcgk,
+     &        rhsgi, rhsgj, rhsgk, residualgi, residualgj, residualgk,
+     &        solngi, solngj, solngk, sfgi, sfgj, sfgk, sfvar
+      double precision xdc(ifirst-dcgi:ilast+1+dcgi,
+     &                     jfirst-dcgj:jlast+dcgj,
+     &                     kfirst-dcgk:klast+dcgk)
+      double precision ydc(ifirst-dcgi:ilast+dcgi,
+     &                     jfirst-dcgj:jlast+1+dcgj,
+     &                     kfirst-dcgk:klast+dcgk)
+      double precision zdc(ifirst-dcgi:ilast+dcgi,
+     &                     jfirst-dcgj:jlast+dcgj,
+     &                     kfirst-dcgk:klast+1+dcgk)
+      double precision soln(ifirst-solngi:ilast+solngi,
+     &                      jfirst-solngj:jlast+solngj,
+     &                      kfirst-solngk:klast+solngk)
+      double precision rhs(ifirst-rhsgi:ilast+rhsgi,
+     &                     jfirst-rhsgj:jlast+rhsgj,
+     &                     kfirst-rhsgk:klast+rhsgk)
+      double precision residual(ifirst-residualgi:ilast+residualgi,
+     &                          jfirst-residualgj:jlast+residualgj,
+     &                          kfirst-residualgk:klast+residualgk)
+      double precision scalar_field(ifirst-sfgi:ilast+sfgi,
+     &                              jfirst-sfgj:jlast+sfgj,
+     &                              kfirst-sfgk:klast+sfgk)
+      double precision sfconst
+      double precision dx(0:2)
+
+      double precision dxi, dyi, dzi, sf
+      integer i, j, k
+
+      dxi = 1./dx(0)
+      dyi = 1./dx(1)
+      dzi = 1./dx(2)
+      sf = sfconst
+
+      do k=kfirst,klast
+      do j=jfirst,jlast
+         do i=ifirst,ilast
+             if ( sfvar .eq. 1 ) sf = scalar_field(i,j,k)
+             residual(i,j,k)
+     &          = rhs(i,j,k)
+     &          - ( dxi*( dxi*xdc(i+1,j,k)*(soln(i+1,j,k)-soln(i,j,k))
+     &                  - dxi*xdc(i,j,k)*(soln(i,j,k)-soln(i-1,j,k)) )
+     &            + dyi*( dyi*ydc(i,j+1,k)*(soln(i,j+1,k)-soln(i,j,k))
+     &                  - dyi*ydc(i,j,k)*(soln(i,j,k)-soln(i,j-1,k)) )
+     &            + dzi*( dzi*zdc(i,j,k+1)*(soln(i,j,k+1)-soln(i,j,k))
+     &                  - dzi*zdc(i,j,k)*(soln(i,j,k)-soln(i,j,k-1)) ) )
+     &          - sf*soln(i,j,k)
+         enddo
+      enddo
+      enddo
+      return
+      end
+c***********************************************************************
+c***********************************************************************
+      subroutine compresfusedcondc3d(
+     &dc ,
+     &rhs , rhsgi, rhsgj , rhsgk ,
+     &residual , residualgi, residualgj , residualgk ,
+     &scalar_field , sfgi, sfgj , sfgk , sfconst , sfvar ,
+     &soln , solngi, solngj , solngk ,
+     &ifirst, ilast, jfirst, jlast , kfirst, klast ,
+     &dx )
+
+      implicit none
+      integer ifirst, ilast, jfirst, jlast, kfirst, klast
+      integer rhsgi, rhsgj, rhsgk, residualgi, residualgj, residualgk,
+     &        solngi, solngj, solngk, sfgi, sfgj, sfgk, sfvar
+      double precision dc
+      double precision soln(ifirst-solngi:ilast+solngi,
+     &                      jfirst-solngj:jlast+solngj,
+     &                      kfirst-solngk:klast+solngk)
+      double precision rhs(ifirst-rhsgi:ilast+rhsgi,
+     &                     jfirst-rhsgj:jlast+rhsgj,
+     &                     kfirst-rhsgk:klast+rhsgk)
+      double precision residual(ifirst-residualgi:ilast+residualgi,
+     &                          jfirst-residualgj:jlast+residualgj,
+     &                          kfirst-residualgk:klast+residualgk)
+      double precision scalar_field(ifirst-sfgi:ilast+sfgi,
+     &                              jfirst-sfgj:jlast+sfgj,
+     &                              kfirst-sfgk:klast+sfgk)
+      double precision sfconst
+      double precision dx(0:2)
+
+      double precision dxi, dyi, dzi, sf
+      integer i, j, k
+
+      dxi = 1./dx(0)
+      dyi = 1./dx(1)
+      dzi = 1./dx(2)
+      sf = sfconst
+
+      do k=kfirst,klast
+      do j=jfirst,jlast
+         do i=ifirst,ilast
+             if ( sfvar .eq. 1 ) sf = scalar_field(i,j,k)
+             residual(i,j,k)
+     &          = rhs(i,j,k)
+     &          - ( dxi*( dxi*dc*(soln(i+1,j,k)-soln(i,j,k))
+     &                  - dxi*dc*(soln(i,j,k)-soln(i-1,j,k)) )
+     &            + dyi*( dyi*dc*(soln(i,j+1,k)-soln(i,j,k))
+     &                  - dyi*dc*(soln(i,j,k)-soln(i,j-1,k)) )
+     &            + dzi*( dzi*dc*(soln(i,j,k+1)-soln(i,j,k))
+     &                  - dzi*dc*(soln(i,j,k)-soln(i,j,k-1)) ) )
+     &          - sf*soln(i,j,k)
+         enddo
+      enddo
+      enddo
+      return
+      end
+c***********************************************************************
+c One step of the Jacobi-preconditioned Chebyshev iteration:
+c dir = alpha*dir + beta*(residual/diagonal), soln = soln + dir.
+c***********************************************************************
+      subroutine chebyupdatevardc3d(
+     &xdc , ydc , zdc, dcgi, dcgj , dcgk ,
+     &residual , residualgi, residualgj , residualgk ,
+     &scalar_field , sfgi, sfgj , sfgk , sfconst , sfvar ,
+     &soln , solngi, solngj , solngk ,
+     &dir , dirgi, dirgj , dirgk ,
+     &ifirst, ilast, jfirst, jlast , kfirst, klast ,
+     &dx ,
+     &alpha, beta, maxres )
+
+      implicit none
+      integer ifirst, ilast, jfirst, jlast, kfirst, klast
+      integer dcgi, dcgj, dcgk, residualgi, residualgj, residualgk,
+     &        solngi, solngj, solngk, sfgi, sfgj, sfgk, sfvar,
+     &        dirgi, dirgj, dirgk
+      double precision xdc(ifirst-dcgi:ilast+1+dcgi,
+     &                     jfirst-dcgj:jlast+dcgj,
+     &                     kfirst-dcgk:klast+dcgk)
+      double precision ydc(ifirst-dcgi:ilast+dcgi,
+     &                     jfirst-dcgj:jlast+1+dcgj,
+     &                     kfirst-dcgk:klast+dcgk)
+      double precision zdc(ifirst-dcgi:ilast+dcgi,
+     &                     jfirst-dcgj:jlast+dcgj,
+     &                     kfirst-dcgk:klast+1+dcgk)
+      double precision soln(ifirst-solngi:ilast+solngi,
+     &                      jfirst-solngj:jlast+solngj,
+     &                      kfirst-solngk:klast+solngk)
+      double precision residual(ifirst-residualgi:ilast+residualgi,
+     &                          jfirst-residualgj:jlast+residualgj,
+     &                          kfirst-residualgk:klast+residualgk)
+      double precision scalar_field(ifirst-sfgi:ilast+sfgi,
+     &                              jfirst-sfgj:jlast+sfgj,
+     &                              kfirst-sfgk:klast+sfgk)
+      double precision dir(ifirst-dirgi:ilast+dirgi,
+     &                     jfirst-dirgj:jlast+dirgj,
+     &                     kfirst-dirgk:klast+dirgk)
+      double precision sfconst
+      double precision dx(0:2)
+      double precision alpha, beta
+      double precision maxres
+
+      double precision dxi, dyi, dzi, dxi2, dyi2, dzi2
+      double precision dudr, sf
+      integer i, j, k
+
+      dxi = 1./dx(0)
+      dyi = 1./dx(1)
+      dzi = 1./dx(2)
+      dxi2 = dxi*dxi
+      dyi2 = dyi*dyi
+      dzi2 = dzi*dzi
+
+      maxres = 0.0
+      sf = sfconst
+
+      do k=kfirst,klast
+      do j=jfirst,jlast
+         do i=ifirst,ilast
+             if ( sfvar .eq. 1 ) sf = scalar_field(i,j,k)
+             dudr = 1./( ( dxi2*( xdc(i+1,j,k)+xdc(i,j,k) )
+     &                   + dyi2*( ydc(i,j+1,k)+ydc(i,j,k) )
+     &                   + dzi2*( zdc(i,j,k+1)+zdc(i,j,k) ) )
+     &                   - sf )
+             dir(i,j,k) = alpha*dir(i,j,k) - beta*residual(i,j,k)*dudr
+             soln(i,j,k) = soln(i,j,k) + dir(i,j,k)
+             if ( maxres .lt. abs(residual(i,j,k)) )
+     &          maxres = abs(residual(i,j,k))
+         enddo
+      enddo
+      enddo
+      return
+      end
+c***********************************************************************
+c***********************************************************************
+      subroutine chebyupdatecondc3d(
+     &dc ,
+     &residual , residualgi, residualgj , residualgk ,
+     &scalar_field , sfgi, sfgj , sfgk , sfconst , sfvar ,
+     &soln , solngi, solngj , solngk ,
+     &dir , dirgi, dirgj , dirgk ,
+     &ifirst, ilast, jfirst, jlast , kfirst, klast ,
+     &dx ,
+     &alpha, beta, maxres )
+
+      implicit none
+      integer ifirst, ilast, jfirst, jlast, kfirst, klast
+      integer residualgi, residualgj, residualgk,
+     &        solngi, solngj, solngk, sfgi, sfgj, sfgk, sfvar,
+     &        dirgi, dirgj, dirgk
+      double precision dc
+      double precision soln(ifirst-solngi:ilast+solngi,
+     &                      jfirst-solngj:jlast+solngj,
+     &                      kfirst-solngk:klast+solngk)
+      double precision residual(ifirst-residualgi:ilast+residualgi,
+     &                          jfirst-residualgj:jlast+residualgj,
+     &                          kfirst-residualgk:klast+residualgk)
+      double precision scalar_field(ifirst-sfgi:ilast+sfgi,
+     &                              jfirst-sfgj:jlast+sfgj,
+     &                              kfirst-sfgk:klast+sfgk)
+      double precision dir(ifirst-dirgi:ilast+dirgi,
+     &                     jfirst-dirgj:jlast+dirgj,
+     &                     kfirst-dirgk:klast+dirgk)
+      double precision sfconst
+      double precision dx(0:2)
+      double precision alpha, beta
+      double precision maxres
+
+      double precision dxi, dyi, dzi, dxi2, dyi2, dzi2
+      double precision dudr, sf
+      integer i, j, k
+
+      dxi = 1./dx(0)
+      dyi = 1./dx(1)
+      dzi = 1./dx(2)
+      dxi2 = dxi*dxi
+      dyi2 = dyi*dyi
+      dzi2 = dzi*dzi
+
+      maxres = 0.0
+      sf = sfconst
+
+      do k=kfirst,klast
+      do j=jfirst,jlast
+         do i=ifirst,ilast
+             if ( sfvar .eq. 1 ) sf = scalar_field(i,j,k)
+             dudr = 1./( ( dxi2*( dc + dc )
+     &                   + dyi2*( dc + dc )
+     &                   + dzi2*( dc + dc ) )
+     &                   - sf )
+             dir(i,j,k) = alpha*dir(i,j,k) - beta*residual(i,j,k)*dudr
+             soln(i,j,k) = soln(i,j,k) + dir(i,j,k)
+             if ( maxres .lt. abs(residual(i,j,k)) )
+     &          maxres = abs(residual(i,j,k))
+         enddo
+      enddo
+      enddo
+      return
+      end
+c***********************************************************************
@@ -342,6 +342,59 @@ public:
       const float * const data,
       const size_t nelements);
 
+   /**
+    * Create a float array entry in the database with the specified
+    * key name, stored as a single chunk passed through the given HDF5
+    * filter.
+    *
+    * The filter must be registered with the HDF5 library when the entry
+    * is written and when it is read; reading is then done with
+    * getFloatVector() as for unfiltered entries.
+    *
+    * @pre !key.empty()
+    * @pre data != 0
+    */
+   void
+   putFilteredFloatArray(
+      const std::string& key,
+      const float * const data,
+      const size_t nelements,
+      H5Z_filter_t filter,
+      const std::vector<unsigned int>& filter_parameters);
+
+   /**
+    * Create a float or double array entry in the database with the
+    * specified key name without writing its values, and return the
+    * address of its storage in the file.
+    *
+    * The storage is contiguous and allocated when the entry is created,
+    * so the values may be written later directly to the file at the
+    * returned address, e.g. with MPI-IO by processes that do not use
+    * HDF5, in the representation given by convertToFileRepresentation().
+    * The values are undefined until they are written.
+    *
+    * @pre !key.empty()
+    * @pre type == SAMRAI_FLOAT || type == SAMRAI_DOUBLE
+    * @pre nelements > 0
+    */
+   haddr_t
+   putUnwrittenArray(
+      const std::string& key,
+      const Database::DataType type,
+      const size_t nelements);
+
+   /**
+    * Convert native float or double values in place to the
+    * representation of float or double arrays in the file.
+    *
+    * @pre type == SAMRAI_FLOAT || type == SAMRAI_DOUBLE
+    */
+   static void
+   convertToFileRepresentation(
+      const Database::DataType type,
+      void* data,
+      const size_t nelements);
+
    /**
     * Get a float entry from the database with the specified key
     * name.  If the specified key does not exist in the database
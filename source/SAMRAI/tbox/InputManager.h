@@ -50,6 +50,16 @@ namespace tbox {
  * For convenience, the input parser also supports C/C++ style comments,
  * "include" files, and some expression evaluation.
  *
+ * Parsing is done by every processor.  For very large inputs, the parsed
+ * database may be written once to a binary serialized input file with
+ * writeSerializedInputFile().  Serialized input files are recognized by
+ * parseInputFile() and are not parsed: processor 0 reads the file and
+ * broadcasts it, or, if setMapSerializedInputFiles() is set, every
+ * processor memory-maps the file.  The values of a serialized input
+ * are deserialized on the first access of their key (see
+ * MemoryDatabase::deserialize()), so the cost of reading it is in
+ * proportion to the part of the input used.
+ *
  */
 
 class InputManager
@@ -123,12 +133,44 @@ public:
 
    /**
     * Parse data from the specified file into the existing database.
+    *
+    * If the file is a serialized input file, the contents of the
+    * database are replaced by those of the serialized database.
     */
    void
    parseInputFile(
       const std::string& filename,
       const std::shared_ptr<InputDatabase>& input_db);
 
+   /**
+    * Write the binary serialized form of an input database to a file,
+    * to be read by parseInputFile() instead of the input file it was
+    * parsed from.
+    *
+    * All processors must call this routine; processor 0 writes the file.
+    * The serialized form is in the native byte order of processor 0.
+    *
+    * @param filename
+    * @param input_db
+    */
+   void
+   writeSerializedInputFile(
+      const std::string& filename,
+      const InputDatabase& input_db);
+
+   /**
+    * Set whether serialized input files are memory-mapped by every
+    * processor instead of read by processor 0 and broadcast.  Mapping
+    * avoids the broadcast when the file is on a file system shared by
+    * all processors.  The default is false.
+    */
+   void
+   setMapSerializedInputFiles(
+      bool map_serialized_input_files)
+   {
+      d_map_serialized_input_files = map_serialized_input_files;
+   }
+
 protected:
    /**
     * The constructor is protected, since only subclasses of the singleton
@@ -158,6 +200,25 @@ private:
    static void
    finalizeCallback();
 
+   /**
+    * Read a serialized input file into the database, by broadcast or by
+    * memory-mapping it.
+    */
+   void
+   readSerializedInputFile(
+      const std::string& filename,
+      const std::shared_ptr<InputDatabase>& input_db);
+
+   /**
+    * Deleter of the memory of a memory-mapped serialized input file.
+    */
+   struct UnmapFile;
+
+   /**
+    * Whether serialized input files are memory-mapped.
+    */
+   bool d_map_serialized_input_files;
+
    static InputManager* s_manager_instance;
 
    static StartupShutdownManager::Handler s_finalize_handler;
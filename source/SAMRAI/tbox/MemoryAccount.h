@@ -0,0 +1,197 @@
+/*************************************************************************
+ *
+ * This file is part of the SAMRAI distribution.  For full copyright
+ * information, see COPYRIGHT and LICENSE.
+ *
+ * Copyright:     (c) 1997-2017 Lawrence Livermore National Security, LLC
+ * Description:   Memory footprint of an object, kept by MemoryAccountant
+ *
+ ************************************************************************/
+
+#ifndef included_tbox_MemoryAccount
+#define included_tbox_MemoryAccount
+
+#include "SAMRAI/SAMRAI_config.h"
+
+#include "SAMRAI/tbox/MemoryAccountant.h"
+
+namespace SAMRAI {
+namespace tbox {
+
+/*!
+ * @brief Class MemoryAccount holds the memory footprint of an object and
+ * keeps the MemoryAccountant informed of it.
+ *
+ * An object accounting for its memory has a MemoryAccount member and
+ * sets its footprint with setBytes() when its data changes.  The account
+ * removes the footprint from the accountant when it is destroyed.  A copy
+ * of an account adds its footprint again, as the copy of the object holds
+ * a copy of the data.
+ *
+ * An account with a negative category accounts for nothing.
+ *
+ * @see MemoryAccountant
+ */
+
+class MemoryAccount
+{
+public:
+   /*!
+    * @brief Constructor.
+    *
+    * @param[in] category  Category from MemoryAccountant::getCategory().
+    * @param[in] level  Level number or MemoryAccountant::NO_LEVEL.
+    */
+   explicit MemoryAccount(
+      int category = -1,
+      int level = MemoryAccountant::NO_LEVEL):
+      d_category(category),
+      d_level(level),
+      d_bytes(0)
+   {
+   }
+
+   /*!
+    * @brief Copy constructor.
+    *
+    * The copy has the category, level and footprint of other.
+    */
+   MemoryAccount(
+      const MemoryAccount& other):
+      d_category(other.d_category),
+      d_level(other.d_level),
+      d_bytes(0)
+   {
+      setBytes(other.d_bytes);
+   }
+
+   /*!
+    * @brief Destructor removes the footprint from the accountant.
+    */
+   ~MemoryAccount()
+   {
+      setBytes(0);
+   }
+
+   /*!
+    * @brief Assignment operator.
+    *
+    * The footprint becomes that of rhs; the category and level are kept.
+    */
+   MemoryAccount&
+   operator = (
+      const MemoryAccount& rhs)
+   {
+      setBytes(rhs.d_bytes);
+      return *this;
+   }
+
+   /*!
+    * @brief Set the footprint.
+    */
+   void
+   setBytes(
+      size_t bytes)
+   {
+      if (d_category >= 0 && bytes != d_bytes) {
+         if (bytes > d_bytes) {
+            MemoryAccountant::addBytes(d_category, d_level, bytes - d_bytes);
+         } else {
+            MemoryAccountant::removeBytes(d_category, d_level, d_bytes - bytes);
+         }
+      }
+      d_bytes = bytes;
+   }
+
+   /*!
+    * @brief Add to the footprint.
+    */
+   void
+   addBytes(
+      size_t bytes)
+   {
+      setBytes(d_bytes + bytes);
+   }
+
+   /*!
+    * @brief Remove from the footprint.
+    *
+    * @pre bytes <= getBytes()
+    */
+   void
+   removeBytes(
+      size_t bytes)
+   {
+      TBOX_ASSERT(bytes <= d_bytes);
+      setBytes(d_bytes - bytes);
+   }
+
+   /*!
+    * @brief Return the footprint.
+    */
+   size_t
+   getBytes() const
+   {
+      return d_bytes;
+   }
+
+   /*!
+    * @brief Move the footprint to another category.
+    */
+   void
+   setCategory(
+      int category)
+   {
+      if (category != d_category) {
+         const size_t bytes = d_bytes;
+         setBytes(0);
+         d_category = category;
+         setBytes(bytes);
+      }
+   }
+
+   /*!
+    * @brief Return the category.
+    */
+   int
+   getCategory() const
+   {
+      return d_category;
+   }
+
+   /*!
+    * @brief Move the footprint to another level.
+    */
+   void
+   setLevel(
+      int level)
+   {
+      if (level != d_level) {
+         const size_t bytes = d_bytes;
+         setBytes(0);
+         d_level = level;
+         setBytes(bytes);
+      }
+   }
+
+   /*!
+    * @brief Return the level number.
+    */
+   int
+   getLevel() const
+   {
+      return d_level;
+   }
+
+private:
+   int d_category;
+
+   int d_level;
+
+   size_t d_bytes;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,306 @@
+/*************************************************************************
+ *
+ * This file is part of the SAMRAI distribution.  For full copyright
+ * information, see COPYRIGHT and LICENSE.
+ *
+ * Copyright:     (c) 1997-2017 Lawrence Livermore National Security, LLC
+ * Description:   Singleton accounting of the memory used by library objects
+ *
+ ************************************************************************/
+
+#ifndef included_tbox_MemoryAccountant
+#define included_tbox_MemoryAccountant
+
+#include "SAMRAI/SAMRAI_config.h"
+
+#include "SAMRAI/tbox/IOStream.h"
+#include "SAMRAI/tbox/OpenMPUtilities.h"
+#include "SAMRAI/tbox/PIO.h"
+#include "SAMRAI/tbox/SAMRAI_MPI.h"
+#include "SAMRAI/tbox/StartupShutdownManager.h"
+#include "SAMRAI/tbox/Utilities.h"
+
+#include <string>
+#include <vector>
+
+namespace SAMRAI {
+namespace tbox {
+
+class MemoryAccount;
+
+/*!
+ * @brief Class MemoryAccountant is a Singleton class that keeps track of
+ * the memory used by library objects, by category and level.
+ *
+ * Where MemoryUtilities reports the heap usage of the whole process, the
+ * memory accountant tells which kind of object uses the memory.  Objects
+ * register their footprint through a MemoryAccount member, which holds
+ * the category (usually one per class, such as "hier::BoxLevel"), the
+ * number of the hierarchy level the object belongs to, and the number of
+ * bytes the object currently uses.  The accountant sums the accounts into
+ * the current usage of each category and level, and remembers the largest
+ * usage seen (the high-water mark).
+ *
+ * The library accounts for the patch data of patches (as given by
+ * hier::PatchDataFactory::getSizeOfMemory()), BoxLevels, Connectors,
+ * the Connectors cached by PersistentOverlapConnectors, and the
+ * transactions of RefineSchedules and CoarsenSchedules.  The footprints
+ * are estimates computed from the sizes of the containers holding the
+ * data, updated when the objects change, so they cost little to keep.
+ *
+ * print() reduces the usage across the ranks and writes the local,
+ * minimum, average and maximum usage of each category and level.
+ * TimerManager::print() calls it when the timer manager input parameter
+ * print_memory is TRUE, so that the memory usage is written alongside
+ * the timings.
+ *
+ * Objects built before SAMRAIManager::initialize() or destroyed after
+ * SAMRAIManager::finalize() are not accounted for.
+ *
+ * @see MemoryAccount
+ */
+
+class MemoryAccountant
+{
+   friend class MemoryAccount;
+public:
+   /*!
+    * @brief Level number of objects that do not belong to a hierarchy
+    * level.
+    */
+   static const int NO_LEVEL = -1;
+
+   /*!
+    * @brief Return a pointer to the singleton instance of the memory
+    * accountant, creating it if it does not exist.
+    */
+   static MemoryAccountant *
+   getManager();
+
+   /*!
+    * @brief Return the identifier of the category of the given name,
+    * adding the category if it does not exist.
+    *
+    * Classes get their category when they initialize their timers, and
+    * pass it to the MemoryAccount of their objects.  All ranks must add
+    * the same categories in the same order for print() to match them.
+    *
+    * @pre !name.empty()
+    */
+   int
+   getCategory(
+      const std::string& name);
+
+   /*!
+    * @brief Return the number of categories.
+    */
+   int
+   getNumberOfCategories() const
+   {
+      return static_cast<int>(d_categories.size());
+   }
+
+   /*!
+    * @brief Return the name of a category.
+    *
+    * @pre category >= 0 && category < getNumberOfCategories()
+    */
+   const std::string&
+   getCategoryName(
+      int category) const
+   {
+      TBOX_ASSERT(category >= 0 && category < getNumberOfCategories());
+      return d_categories[category].d_name;
+   }
+
+   /*!
+    * @brief Return the number of bytes currently used by a category on
+    * this rank, on all levels or on the given level.
+    *
+    * @param[in] category
+    * @param[in] level  Level number, NO_LEVEL for objects not on a level,
+    *                   or less than NO_LEVEL for all levels.
+    *
+    * @pre category >= 0 && category < getNumberOfCategories()
+    */
+   size_t
+   getCurrentBytes(
+      int category,
+      int level = NO_LEVEL - 1) const;
+
+   /*!
+    * @brief Return the largest number of bytes used by a category on
+    * this rank, on all levels or on the given level, since the start of
+    * the run or the last call to resetHighWaterMarks().
+    *
+    * @param[in] category
+    * @param[in] level  Level number, NO_LEVEL for objects not on a level,
+    *                   or less than NO_LEVEL for all levels.
+    *
+    * @pre category >= 0 && category < getNumberOfCategories()
+    */
+   size_t
+   getHighWaterBytes(
+      int category,
+      int level = NO_LEVEL - 1) const;
+
+   /*!
+    * @brief Return the number of bytes currently used by all categories
+    * on this rank.
+    */
+   size_t
+   getTotalCurrentBytes() const
+   {
+      return d_total.d_current;
+   }
+
+   /*!
+    * @brief Return the high-water mark of the bytes used by all
+    * categories on this rank.
+    */
+   size_t
+   getTotalHighWaterBytes() const
+   {
+      return d_total.d_high_water;
+   }
+
+   /*!
+    * @brief Reset the high-water marks to the current usage.
+    *
+    * This is useful to measure the usage of a phase of a run, such as a
+    * regrid.
+    */
+   void
+   resetHighWaterMarks();
+
+   /*!
+    * @brief Print the memory usage of each category and level.
+    *
+    * For each category, a line gives the usage over all levels, followed
+    * by a line for each level used by the category on any rank.  Each line
+    * gives the current usage and the high-water mark on this rank and
+    * their minimum, average and maximum over the ranks, with the rank of
+    * the maximum.  Categories that were never used on any rank are not
+    * printed.
+    *
+    * This method is collective over mpi.
+    *
+    * @param[in] os
+    * @param[in] mpi  Communicator over which to reduce the usage.
+    */
+   void
+   print(
+      std::ostream& os = plog,
+      const SAMRAI_MPI& mpi = SAMRAI_MPI::getSAMRAIWorld());
+
+private:
+   /*
+    * Usage of a category on a level, or a sum of them.
+    */
+   struct Usage {
+      Usage():
+         d_current(0),
+         d_high_water(0)
+      {
+      }
+      size_t d_current;
+      size_t d_high_water;
+   };
+
+   /*
+    * Usage of a category.  d_levels[0] holds the usage of objects not on
+    * a level and d_levels[ln + 1] that of level ln.
+    */
+   struct Category {
+      std::string d_name;
+      Usage d_total;
+      std::vector<Usage> d_levels;
+   };
+
+   MemoryAccountant();
+
+   ~MemoryAccountant();
+
+   // Unimplemented copy constructor.
+   MemoryAccountant(
+      const MemoryAccountant& other);
+
+   // Unimplemented assignment operator.
+   MemoryAccountant&
+   operator = (
+      const MemoryAccountant& rhs);
+
+   /*!
+    * @brief Add bytes to the usage of a category on a level.
+    *
+    * Does nothing if the accountant does not exist.
+    */
+   static void
+   addBytes(
+      int category,
+      int level,
+      size_t bytes);
+
+   /*!
+    * @brief Remove bytes from the usage of a category on a level.
+    *
+    * Does nothing if the accountant does not exist.
+    */
+   static void
+   removeBytes(
+      int category,
+      int level,
+      size_t bytes);
+
+   /*!
+    * @brief Return the usage of a category on a level, which must exist.
+    */
+   Usage&
+   getUsage(
+      int category,
+      int level);
+
+   /*!
+    * @brief Write a line of the table written by print().
+    */
+   void
+   printLine(
+      std::ostream& os,
+      const std::string& name,
+      const std::string& level,
+      const double local[2],
+      const double min[2],
+      const double sum[2],
+      const double max[2],
+      const int max_rank[2],
+      int nprocs) const;
+
+   /*!
+    * @brief Free the singleton instance.
+    *
+    * Only called by StartupShutdownManager.
+    */
+   static void
+   finalizeCallback();
+
+   static MemoryAccountant* s_memory_accountant_instance;
+
+   std::vector<Category> d_categories;
+
+   /*
+    * Usage summed over all categories.
+    */
+   Usage d_total;
+
+   /*
+    * Lock for changes of the usage from multiple threads.
+    */
+   TBOX_omp_lock_t l_usage;
+
+   static StartupShutdownManager::Handler s_finalize_handler;
+};
+
+}
+}
+
+#endif
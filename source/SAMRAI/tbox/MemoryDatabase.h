@@ -16,6 +16,9 @@
 #include "SAMRAI/tbox/Database.h"
 
 #include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
 namespace SAMRAI {
 namespace tbox {
@@ -46,6 +49,26 @@ namespace tbox {
  *
  * It is assumed that all processors will access the database in the same
  * manner.  Thus, all error messages are output to pout instead of perr.
+ *
+ * Keys are found through a hash table, and the records of the keys and
+ * the nodes of the hash table are allocated from an arena owned by the
+ * database, so that a database with many keys, such as the restart data
+ * of a large run staged in memory, costs a constant time per key.  The
+ * values of the keys (arrays, strings and sub-databases) are allocated
+ * from the heap, as std::vector and std::string allocate them.  Large
+ * double, float and integer arrays may be moved into and out of the
+ * database with the rvalue overloads of putDoubleVector(),
+ * putFloatVector() and putIntegerVector() and with takeDoubleVector(),
+ * takeFloatVector() and takeIntegerVector(), which avoid copying the
+ * array.
+ *
+ * A memory database can be written to a binary serialized form with
+ * serialize() and rebuilt from it with deserialize().  Deserializing
+ * reads only the keys of the top database; each value, including nested
+ * databases, is deserialized on the first access of its key, so reading
+ * a large serialized input costs in proportion to the part of it used.
+ * The serialized form is in the native byte order and is meant to be
+ * read on machines of the same architecture, e.g. by InputManager.
  */
 
 class MemoryDatabase:public Database
@@ -848,6 +871,73 @@ public:
    virtual std::string
    getName();
 
+   /**
+    * Create a double vector entry in the database with the specified
+    * key name, moving the vector into the database instead of copying
+    * it.  If the key already exists in the database, then the old key
+    * record is deleted and the new one is silently created in its place.
+    */
+   void
+   putDoubleVector(
+      const std::string& key,
+      std::vector<double>&& data);
+
+   /**
+    * Create a float vector entry in the database with the specified
+    * key name, moving the vector into the database instead of copying
+    * it.  If the key already exists in the database, then the old key
+    * record is deleted and the new one is silently created in its place.
+    */
+   void
+   putFloatVector(
+      const std::string& key,
+      std::vector<float>&& data);
+
+   /**
+    * Create an integer vector entry in the database with the specified
+    * key name, moving the vector into the database instead of copying
+    * it.  If the key already exists in the database, then the old key
+    * record is deleted and the new one is silently created in its place.
+    */
+   void
+   putIntegerVector(
+      const std::string& key,
+      std::vector<int>&& data);
+
+   /**
+    * Remove an entry from the database and return its value as a double
+    * vector.  A double value is moved out of the database instead of
+    * being copied; other values are promoted as by getDoubleVector().
+    * If the specified key does not exist in the database or its value
+    * cannot be promoted to double, then an error message is printed and
+    * the program exits.
+    */
+   std::vector<double>
+   takeDoubleVector(
+      const std::string& key);
+
+   /**
+    * Remove an entry from the database and return its value as a float
+    * vector.  A float value is moved out of the database instead of
+    * being copied; other values are converted as by getFloatVector().
+    * If the specified key does not exist in the database or its value
+    * cannot be converted to float, then an error message is printed and
+    * the program exits.
+    */
+   std::vector<float>
+   takeFloatVector(
+      const std::string& key);
+
+   /**
+    * Remove an integer entry from the database and return its value
+    * without copying it.  If the specified key does not exist in the
+    * database or is not an integer vector, then an error message is
+    * printed and the program exits.
+    */
+   std::vector<int>
+   takeIntegerVector(
+      const std::string& key);
+
    /**
     * Return whether the specified key has been accessed by one of the
     * lookup member functions.  If the key does not exist in the database,
@@ -861,6 +951,21 @@ public:
       return keydata ? keydata->d_accessed : false;
    }
 
+   /**
+    * Return whether the value of the specified key is still in its
+    * serialized form, that is the database was rebuilt by deserialize()
+    * and the key has not been looked up since.  This does not
+    * deserialize the value.  If the key does not exist in the database,
+    * then false is returned.
+    */
+   bool
+   keySerialized(
+      const std::string& key) const
+   {
+      KeyIndex::const_iterator i = d_key_index.find(key);
+      return i != d_key_index.end() && i->second->d_serialized != 0;
+   }
+
    /**
     * Print the current database to the specified output stream.  After
     * each key, print whether that key came from the a file and was
@@ -875,6 +980,50 @@ public:
    printClassData(
       std::ostream& os = pout);
 
+   /**
+    * Return whether a buffer starts with a database serialized by
+    * serialize().
+    *
+    * @param[in] buffer
+    * @param[in] size  Size of the buffer in bytes.
+    */
+   static bool
+   isSerialized(
+      const char* buffer,
+      size_t size);
+
+   /**
+    * Append the binary serialized form of the database, including its
+    * nested databases, to a buffer.
+    *
+    * The key accessed and default flags are not serialized.
+    *
+    * @param[in,out] buffer
+    */
+   void
+   serialize(
+      std::vector<char>& buffer) const;
+
+   /**
+    * Replace the contents of the database with those of a database
+    * serialized by serialize().
+    *
+    * Only the keys of the database are read here; values are
+    * deserialized on the first access of their key.  The database and
+    * its nested databases hold the buffer until they are destroyed, so
+    * the buffer may be memory-mapped or shared.  An invalid buffer is
+    * an unrecoverable error.
+    *
+    * @param[in] buffer
+    * @param[in] size  Size of the buffer in bytes.
+    *
+    * @pre buffer
+    */
+   void
+   deserialize(
+      const std::shared_ptr<const char>& buffer,
+      size_t size);
+
    /**
     * Print the database keys that were not used to the specified output
     * stream.
@@ -905,12 +1054,115 @@ private:
    operator = (
       const MemoryDatabase&);                   // not implemented
 
+   /*
+    * Arena the records of the keys and the nodes of the hash table are
+    * allocated from.  Memory is taken from chunks owned by the arena and
+    * freed with it; freed blocks are kept on a free list per size for
+    * reuse.  Blocks larger than MAX_BLOCK_SIZE, like the bucket array of
+    * the hash table, are allocated from the heap.  MAX_BLOCK_SIZE must
+    * hold a node of the list of records (a KeyData and two links).
+    */
+   class Arena
+   {
+public:
+      static const size_t MAX_BLOCK_SIZE = 512;
+
+      Arena();
+
+      ~Arena();
+
+      void *
+      allocate(
+         size_t size);
+
+      void
+      deallocate(
+         void* block,
+         size_t size);
+
+private:
+      Arena(
+         const Arena&);                   // not implemented
+      Arena&
+      operator = (
+         const Arena&);                   // not implemented
+
+      static const size_t CHUNK_SIZE;
+      static const size_t BLOCK_ALIGNMENT = 16;
+
+      std::vector<char *> d_chunks;
+      char* d_chunk_next;
+      char* d_chunk_end;
+      void* d_free_blocks[MAX_BLOCK_SIZE / BLOCK_ALIGNMENT];
+   };
+
+   /*
+    * Standard allocator allocating from an Arena.
+    */
+   template<class TYPE>
+   class ArenaAllocator
+   {
+public:
+      typedef TYPE value_type;
+
+      explicit ArenaAllocator(
+         Arena* arena):
+         d_arena(arena)
+      {
+      }
+
+      template<class OTHER_TYPE>
+      ArenaAllocator(
+         const ArenaAllocator<OTHER_TYPE>& other):
+         d_arena(other.d_arena)
+      {
+      }
+
+      TYPE *
+      allocate(
+         size_t n)
+      {
+         return static_cast<TYPE *>(d_arena->allocate(n * sizeof(TYPE)));
+      }
+
+      void
+      deallocate(
+         TYPE* p,
+         size_t n)
+      {
+         d_arena->deallocate(p, n * sizeof(TYPE));
+      }
+
+      template<class OTHER_TYPE>
+      bool
+      operator == (
+         const ArenaAllocator<OTHER_TYPE>& other) const
+      {
+         return d_arena == other.d_arena;
+      }
+
+      template<class OTHER_TYPE>
+      bool
+      operator != (
+         const ArenaAllocator<OTHER_TYPE>& other) const
+      {
+         return d_arena != other.d_arena;
+      }
+
+      Arena* d_arena;
+   };
+
    /*
     * The following structure holds the list of (key,value) pairs stored
     * in the database.  Note that only one of the arrays contains valid
     * data for any particular key.
     */
    struct KeyData {
+      KeyData():
+         d_serialized(0),
+         d_serialized_size(0)
+      {
+      }
       std::string d_key;                                // key name
       enum Database::DataType d_type;                   // type of entry
       size_t d_array_size;                              // size of array data
@@ -925,11 +1177,24 @@ private:
       std::vector<float> d_float;               // float vector value
       std::vector<int> d_integer;               // integer vector value
       std::vector<std::string> d_string;        // string vector value
+      const char* d_serialized;                 // value not deserialized yet
+      size_t d_serialized_size;                 // size of serialized value
    };
 
+   typedef std::list<KeyData, ArenaAllocator<KeyData> > KeyList;
+   typedef std::unordered_map<std::string, KeyList::iterator,
+                              std::hash<std::string>,
+                              std::equal_to<std::string>,
+                              ArenaAllocator<std::pair<const std::string,
+                                                       KeyList::iterator> > >
+      KeyIndex;
+
    /*
     * Private utility routines for managing the database
     */
+   KeyData&
+   insertKeyData(
+      KeyData& keydata);
    bool
    deleteKeyIfFound(
       const std::string& key);
@@ -955,15 +1220,70 @@ private:
       const int toprint) const;
 
    /*
-    * Private data members - name and a list of (key,value) pairs
+    * Private utility routines for the serialized form of the database
+    */
+   void
+   serializeKeys(
+      std::vector<char>& buffer) const;
+   static void
+   serializeValue(
+      std::vector<char>& buffer,
+      const KeyData& keydata);
+   void
+   deserializeKeys(
+      const char* data,
+      size_t size);
+   void
+   deserializeValue(
+      KeyData& keydata) const;
+   static void
+   appendSerialized(
+      std::vector<char>& buffer,
+      const void* data,
+      size_t size)
+   {
+      const char* bytes = static_cast<const char *>(data);
+      buffer.insert(buffer.end(), bytes, bytes + size);
+   }
+   static void
+   readSerialized(
+      void* value,
+      const char*& data,
+      const char* end,
+      size_t size);
+
+   /*
+    * Private data members - name and a list of (key,value) pairs.  The
+    * list is mutable so that the const print routines can deserialize
+    * the values not accessed yet.
     */
    std::string d_database_name;
-   std::list<KeyData> d_keyvalues;
+   Arena d_arena;
+   mutable KeyList d_keyvalues;
+
+   /*
+    * Hash table from the keys to their records in d_keyvalues.
+    */
+   KeyIndex d_key_index;
+
+   /*
+    * Buffer of the serialized database the values not accessed yet are
+    * deserialized from, if any.
+    */
+   std::shared_ptr<const char> d_serialized_buffer;
 
    static const int PRINT_DEFAULT;
    static const int PRINT_INPUT;
    static const int PRINT_UNUSED;
    static const int SSTREAM_BUFFER;
+
+   /*
+    * Header of the serialized form: tag, version and byte order mark.
+    */
+   static const char SERIALIZED_TAG[8];
+   static const unsigned int SERIALIZED_VERSION;
+   static const unsigned int SERIALIZED_BYTE_ORDER;
+   static const size_t SERIALIZED_HEADER_SIZE;
 };
 
 }
@@ -72,6 +72,25 @@ public:
       const void* data_to_read = 0,
       bool deep_copy = true);
 
+   /*!
+    * @brief Create a Write-mode message stream packing directly into
+    * externally supplied memory.
+    *
+    * The stream does not own the memory and cannot grow beyond it, so
+    * the memory must hold all the data packed into the stream.
+    *
+    * @param[in] num_bytes   Number of bytes of the memory.
+    *
+    * @param[in] data_to_write  Memory to pack into.  It must outlive
+    *   the stream.
+    *
+    * @pre num_bytes >= 1
+    * @pre data_to_write != 0
+    */
+   MessageStream(
+      const size_t num_bytes,
+      void* data_to_write);
+
    /*!
     * @brief Default constructor creates a message stream with a
     * buffer that automatically grows as needed, for writing.
@@ -112,6 +131,8 @@ public:
    {
       if (d_mode == Read) {
          return static_cast<const void *>(d_read_buffer);
+      } else if (d_external_write_buffer) {
+         return static_cast<const void *>(d_external_write_buffer);
       } else {
          return &d_write_buffer[0];
       }
@@ -130,7 +151,8 @@ public:
     * @brief Tell a Write-mode stream to allocate more buffer
     * as needed for data.
     *
-    * It is an error to use this method for a Read-mode stream.
+    * It is an error to use this method for a Read-mode stream or a
+    * stream writing into external memory.
     *
     * @pre writeMode()
     */
@@ -138,6 +160,7 @@ public:
    growBufferAsNeeded()
    {
       TBOX_ASSERT(writeMode());
+      TBOX_ASSERT(d_external_write_buffer == 0);
       d_grow_as_needed = true;
    }
 
@@ -298,6 +321,9 @@ public:
    canCopyIn(
       size_t num_bytes) const
    {
+      if (d_external_write_buffer) {
+         return d_buffer_index + num_bytes <= d_external_write_size;
+      }
       return d_buffer_index + num_bytes <= d_write_buffer.capacity();
    }
 
@@ -327,7 +353,18 @@ private:
       if (!growAsNeeded()) {
          TBOX_ASSERT(canCopyIn(num_bytes));
       }
-      if (num_bytes > 0) {
+      if (d_external_write_buffer) {
+         if (!canCopyIn(num_bytes)) {
+            TBOX_ERROR("MessageStream::copyDataIn: error:\n"
+               << "Packing " << num_bytes << " bytes at offset "
+               << d_buffer_index << " overflows the external buffer of\n"
+               << d_external_write_size << " bytes." << std::endl);
+         }
+         memcpy(d_external_write_buffer + d_buffer_index, input_data,
+            num_bytes);
+         d_buffer_index += num_bytes;
+         d_buffer_size = d_buffer_index;
+      } else if (num_bytes > 0) {
          d_write_buffer.insert(d_write_buffer.end(),
             static_cast<const char *>(input_data),
             static_cast<const char *>(input_data) + num_bytes);
@@ -369,6 +406,13 @@ private:
     */
    std::vector<char> d_write_buffer;
 
+   /*!
+    * @brief Externally supplied memory to write into instead of
+    * d_write_buffer, or null, and its size.
+    */
+   char* d_external_write_buffer;
+   size_t d_external_write_size;
+
    /*!
     * @brief Pointer to the externally supplied memory to read from in
     * shallow-copy Read mode, or the internal copy of the externally supplied
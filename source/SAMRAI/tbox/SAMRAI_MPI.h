@@ -268,6 +268,79 @@ public:
    dupCommunicator(
       const SAMRAI_MPI& other);
 
+   /*!
+    * @brief Internally use a new communicator holding the processes
+    * of a given SAMRAI_MPI that share memory with the local process.
+    *
+    * This is a collective call over the communicator of @c other.
+    * Processes are grouped by the compute node they run on and keep
+    * their relative rank order in the new communicator.  Like
+    * dupCommunicator(), the existing communicator is not freed and
+    * the new one must be freed with freeCommunicator().
+    *
+    * If the MPI library predates MPI-3, each process is put in a
+    * communicator by itself.  If SAMRAI isn't configured with MPI or
+    * MPI is not in use, the result is an identical copy.
+    *
+    * @param[in] other  Contains the communicator to be split.
+    */
+   void
+   splitSharedMemoryCommunicator(
+      const SAMRAI_MPI& other);
+
+   /*!
+    * @brief Internally use a new communicator holding the processes
+    * of a given SAMRAI_MPI that pass the same color.
+    *
+    * This is a collective call over the communicator of @c other.
+    * Processes are ordered by @c key, ties broken by their rank in
+    * @c other.  Like dupCommunicator(), the existing communicator is
+    * not freed and the new one must be freed with freeCommunicator().
+    *
+    * If SAMRAI isn't configured with MPI or MPI is not in use, the
+    * result is an identical copy.
+    *
+    * @param[in] other  Contains the communicator to be split.
+    * @param[in] color  Non-negative group selector.
+    * @param[in] key    Ordering of the local process in its group.
+    *
+    * @pre color >= 0
+    */
+   void
+   splitCommunicator(
+      const SAMRAI_MPI& other,
+      int color,
+      int key);
+
+   /*!
+    * @brief Internally use a new distributed graph communicator over
+    * the processes of a given SAMRAI_MPI, with the given neighbors.
+    *
+    * This is a collective call over the communicator of @c other.
+    * The local process receives from the @c num_sources ranks in
+    * @c sources and sends to the @c num_destinations ranks in
+    * @c destinations, given as ranks in @c other.  Processes are not
+    * reordered, and neighborhood collectives such as
+    * Ineighbor_alltoallv() order the neighbors as given.  Like
+    * dupCommunicator(), the existing communicator is not freed and
+    * the new one must be freed with freeCommunicator().
+    *
+    * @param[in] other  Contains the communicator of the graph processes.
+    * @param[in] num_sources
+    * @param[in] sources
+    * @param[in] num_destinations
+    * @param[in] destinations
+    *
+    * @pre hasNeighborCollectives()
+    */
+   void
+   createDistGraphCommunicator(
+      const SAMRAI_MPI& other,
+      int num_sources,
+      const int* sources,
+      int num_destinations,
+      const int* destinations);
+
    /*!
     * @brief Free the internal communicator and set it to MPI_COMM_NULL.
     *
@@ -498,6 +571,26 @@ public:
       Datatype datatype,
       Op op) const;
 
+   int
+   Alltoall(
+      void* sendbuf,
+      int sendcount,
+      Datatype sendtype,
+      void* recvbuf,
+      int recvcount,
+      Datatype recvtype) const;
+
+   int
+   Alltoallv(
+      void* sendbuf,
+      int* sendcounts,
+      int* sdispls,
+      Datatype sendtype,
+      void* recvbuf,
+      int* recvcounts,
+      int* rdispls,
+      Datatype recvtype) const;
+
    int
    Attr_get(
       int keyval,
@@ -559,6 +652,18 @@ public:
       Datatype recvtype,
       int root) const;
 
+   int
+   Ineighbor_alltoallv(
+      void* sendbuf,
+      int* sendcounts,
+      int* sdispls,
+      Datatype sendtype,
+      void* recvbuf,
+      int* recvcounts,
+      int* rdispls,
+      Datatype recvtype,
+      Request* request) const;
+
    int
    Iprobe(
       int source,
@@ -584,6 +689,15 @@ public:
       int tag,
       Request* request) const;
 
+   int
+   Neighbor_alltoall(
+      void* sendbuf,
+      int sendcount,
+      Datatype sendtype,
+      void* recvbuf,
+      int recvcount,
+      Datatype recvtype) const;
+
    int
    Probe(
       int source,
@@ -638,6 +752,17 @@ public:
       Datatype datatype,
       Op op) const;
 
+   int
+   Scatterv(
+      void* sendbuf,
+      int* sendcounts,
+      int* displs,
+      Datatype sendtype,
+      void* recvbuf,
+      int recvcount,
+      Datatype recvtype,
+      int root) const;
+
    //@}
 
    //@{
@@ -841,6 +966,24 @@ public:
       return s_mpi_is_initialized;
    }
 
+   /*!
+    * @brief Whether SAMRAI is using MPI and the MPI library has the
+    * neighborhood collectives of MPI-3.
+    *
+    * @see createDistGraphCommunicator(), Ineighbor_alltoallv()
+    */
+   static bool
+   hasNeighborCollectives()
+   {
+#if defined(HAVE_MPI) && MPI_VERSION >= 3
+      return s_mpi_is_initialized;
+
+#else
+      return false;
+
+#endif
+   }
+
    /*!
     * @brief Initialize MPI and SAMRAI_MPI.
     *
@@ -16,12 +16,14 @@
 #include "SAMRAI/tbox/AsyncCommStage.h"
 #include "SAMRAI/tbox/SAMRAI_MPI.h"
 #include "SAMRAI/tbox/MessageStream.h"
+#include "SAMRAI/tbox/SharedMemoryWindow.h"
 #include "SAMRAI/tbox/Transaction.h"
 
 #include <iostream>
 #include <map>
 #include <list>
 #include <memory>
+#include <vector>
 
 namespace SAMRAI {
 namespace tbox {
@@ -101,6 +103,24 @@ public:
    appendTransaction(
       const std::shared_ptr<Transaction>& transaction);
 
+   /*!
+    * @brief Append all transactions of another schedule to the tails
+    * of the lists of transactions in this schedule.
+    *
+    * The transactions are shared with the other schedule, not copied.
+    * Executing this schedule then sends the transactions of both
+    * schedules for a given peer in a single message.  Processes that
+    * append the same schedules in the same order agree on the
+    * contents of each message.
+    *
+    * @param other  Schedule whose transactions are appended.
+    *
+    * @pre getMPI().getRank() == other.getMPI().getRank()
+    */
+   void
+   appendTransactions(
+      const Schedule& other);
+
    /*!
     * @brief Return number of send transactions in the schedule.
     */
@@ -125,6 +145,18 @@ public:
       return static_cast<int>(d_local_set.size());
    }
 
+   /*!
+    * @brief Return an estimate of the memory used by the schedule to hold
+    * its transactions, in bytes.
+    *
+    * The estimate counts the containers and shared pointers holding the
+    * transactions and the communication objects, if allocated.  It does
+    * not count the transactions themselves, whose size depends on the
+    * concrete Transaction class.
+    */
+   size_t
+   getMemoryFootprint() const;
+
    /*!
     * @brief Set the MPI communicator used for communication.
     *
@@ -132,12 +164,35 @@ public:
     * SAMRAI_MPI::getCommunicator() at the time the Schedule
     * constructor is called is used.  This method may be used to
     * override the default communicator.
+    *
+    * If the schedule has communicated with a neighborhood collective
+    * (see setUseNeighborCollective()), the next communication finds
+    * the graph communicator of its peers over the new communicator.  If
+    * it has communicated through shared memory (see
+    * setUseSharedMemory()), the next communication finds the node
+    * communicator of the new communicator.
+    *
+    * @pre !allocatedCommunicationObjects()
     */
    void
    setMPI(
       const SAMRAI_MPI& mpi)
    {
+      TBOX_ASSERT(!allocatedCommunicationObjects());
+      d_neighbor_mpi.setCommunicator(MPI_COMM_NULL);
+      tearDownSharedMemoryTransport();
       d_mpi = mpi;
+      d_learned_send_lengths.clear();
+      d_learned_recv_lengths.clear();
+   }
+
+   /*!
+    * @brief Get the MPI object used for communication.
+    */
+   const SAMRAI_MPI&
+   getMPI() const
+   {
+      return d_mpi;
    }
 
    /*!
@@ -162,6 +217,18 @@ public:
       d_second_tag = second_tag;
    }
 
+   /*!
+    * @brief Restore the default MPI tag values.
+    *
+    * @see setMPITag()
+    */
+   void
+   resetMPITag()
+   {
+      d_first_tag = s_default_first_tag;
+      d_second_tag = s_default_second_tag;
+   }
+
    /*!
     * @brief Specify the message length (in bytes) used in the first
     * message when the receiving processor cannot determine the
@@ -186,9 +253,12 @@ public:
     * message protocol SAMRAI uses of sending some small amount of
     * data with the first message does exploit this property and will
     * save the cost of always communicating two messages for small
-    * messages.  Currently SAMRAI does not attempt to automatically
-    * determine this message length however that may be added in
-    * future versions.
+    * messages.
+    *
+    * Unless disabled with setLearnMessageLengths(), the first message
+    * length for a peer grows to the length of the last message
+    * exchanged with it, so messages of repeated length are sent in
+    * one piece.
     *
     * first_message_length defaults to 1000.
     *
@@ -204,6 +274,126 @@ public:
       d_first_message_length = static_cast<size_t>(first_message_length);
    }
 
+   /*!
+    * @brief Set whether to learn the message length of each peer.
+    *
+    * Schedules are usually executed many times with messages of the
+    * same lengths.  When learning, the schedule remembers the length of
+    * the last message sent to and received from each peer.  The next
+    * receive from the peer is posted with a buffer of at least the
+    * remembered length, and the next send to the peer goes in a single
+    * message if it is no longer, instead of being split into a first
+    * message of setFirstMessageLength() bytes and a second message
+    * with the rest.  Only messages longer than both the first message
+    * length and the last message take two messages, after which their
+    * length is learned.
+    *
+    * Both sides of a message remember the same length, so they agree on
+    * the split without communicating.  Processes must therefore set the
+    * same flag for matching schedules.  Learning does not apply when the
+    * receiver can compute the incoming message length, which is then
+    * used exactly.
+    *
+    * The flag defaults to true, or to the value of the input parameter
+    * DEV_learn_message_lengths of the Schedule input database.
+    *
+    * @param [in] flag
+    */
+   void
+   setLearnMessageLengths(
+      bool flag)
+   {
+      d_learn_message_lengths = flag;
+      d_learned_send_lengths.clear();
+      d_learned_recv_lengths.clear();
+   }
+
+   /*!
+    * @brief Set whether to exchange the messages with a neighborhood
+    * collective.
+    *
+    * By default each message is sent and received by its own
+    * non-blocking point-to-point operation.  With the neighborhood
+    * collective, the first communication builds a distributed graph
+    * communicator whose neighbors are the peers of the schedule, and
+    * each communication exchanges all messages with one
+    * MPI_Ineighbor_alltoallv, leaving the MPI library free to optimize
+    * the sparse exchange.  Schedules whose peers are the same on all
+    * processes share a graph communicator, and the graph communicators
+    * are only freed when SAMRAI is finalized, so building and
+    * destroying many schedules does not exhaust the communicators of
+    * the MPI library.  Messages are unpacked in the order of the
+    * ranks of their senders.  If a receiver cannot compute the length
+    * of a message, each communication first exchanges the message
+    * lengths with an MPI_Neighbor_alltoall.
+    *
+    * Communication is then collective over getMPI(): all its processes
+    * must set the same flag and communicate together, including those
+    * without transactions.  The peers of the schedule must not change
+    * after the first communication.  beginReceives() posts nothing and
+    * postSendTo() does nothing, the messages all being exchanged by
+    * finalizeCommunication().
+    *
+    * The flag is ignored if the MPI library does not have the MPI-3
+    * neighborhood collectives.  It defaults to the input parameter
+    * use_neighbor_collective of the Schedule input database, or false.
+    *
+    * @param [in] flag
+    *
+    * @pre !allocatedCommunicationObjects()
+    */
+   void
+   setUseNeighborCollective(
+      bool flag)
+   {
+      TBOX_ASSERT(!allocatedCommunicationObjects());
+      d_use_neighbor_collective = flag;
+   }
+
+   /*!
+    * @brief Set whether to exchange the messages between processes of
+    * the same compute node through shared memory.
+    *
+    * By default each message goes through MPI point-to-point
+    * operations, which copy it through the MPI library.  With shared
+    * memory, the first communication groups the processes of getMPI()
+    * by compute node (see
+    * SAMRAI_MPI::splitSharedMemoryCommunicator()).  The node
+    * communicator is made once per communicator and shared by all
+    * schedules.  Each communication gives each process a buffer in an
+    * MPI-3 shared memory window of its node, packs the messages for
+    * the other processes of the node directly into the sender's
+    * buffer, and the receivers unpack them directly from it, so the
+    * data is copied once each way.  finalizeCommunication() frees the
+    * window, so the schedule holds no shared memory between
+    * communications and may be destroyed by each process on its own.
+    * Messages to other nodes still use point-to-point operations.
+    *
+    * Communication is then collective over getMPI(): its processes
+    * must set the same flag and communicate together, including those
+    * without transactions.  finalizeCommunication() waits for the
+    * other processes of the node to pack their messages.  After
+    * beginReceives(), the messages for the node are packed by
+    * finalizeCommunication().
+    *
+    * The flag is ignored with a neighborhood collective (see
+    * setUseNeighborCollective()) or if the MPI library does not have
+    * the MPI-3 shared memory windows.  The flag
+    * defaults to the input parameter use_shared_memory of the Schedule
+    * input database, or false.
+    *
+    * @param [in] flag
+    *
+    * @pre !allocatedCommunicationObjects()
+    */
+   void
+   setUseSharedMemory(
+      bool flag)
+   {
+      TBOX_ASSERT(!allocatedCommunicationObjects());
+      d_use_shared_memory = flag;
+   }
+
    /*!
     * @brief Perform the communication described by the schedule.
     *
@@ -233,6 +423,42 @@ public:
    void
    finalizeCommunication();
 
+   /*!
+    * @brief Begin a communication in which outgoing messages are
+    * posted individually by postSendTo().
+    *
+    * Receives are posted as in beginCommunication(), but no outgoing
+    * data is packed.  This lets the caller produce the source data
+    * for each peer and send it as soon as it is ready, overlapping
+    * data preparation with communication.  Any send not posted
+    * before finalizeCommunication() is posted there.
+    */
+   void
+   beginReceives();
+
+   /*!
+    * @brief Pack and send the outgoing message to the given peer.
+    *
+    * This may only be called between beginReceives() and
+    * finalizeCommunication().  Each peer may be sent to at most
+    * once.  A peer with no outgoing transactions is ignored.
+    *
+    * @param [in] peer_rank
+    *
+    * @pre allocatedCommunicationObjects()
+    */
+   void
+   postSendTo(
+      int peer_rank);
+
+   /*!
+    * @brief Whether the message to the given peer has already been
+    * posted in the current communication.
+    */
+   bool
+   isSendPosted(
+      int peer_rank) const;
+
    /*!
     * @brief Set whether to unpack messages in a deterministic order.
     *
@@ -275,7 +501,7 @@ public:
    bool
    allocatedCommunicationObjects()
    {
-      return d_coms != 0;
+      return d_coms != 0 || d_neighbor_pending || d_node_pending;
    }
 
    /*!
@@ -297,6 +523,7 @@ private:
          delete[] d_coms;
       }
       d_coms = 0;
+      d_send_posted.clear();
    }
 
    void
@@ -304,7 +531,120 @@ private:
    void
    postSends();
    void
+   postSend(
+      size_t isend,
+      const std::list<std::shared_ptr<Transaction> >& transactions);
+   void
    performLocalCopies();
+
+   /*!
+    * @brief Whether messages are exchanged by a neighborhood
+    * collective.
+    */
+   bool
+   usingNeighborCollective() const
+   {
+      return d_use_neighbor_collective &&
+             SAMRAI_MPI::hasNeighborCollectives() &&
+             d_mpi.getSize() > 1;
+   }
+
+   /*!
+    * @brief Create the distributed graph communicator of the peers, or
+    * check that the peers have not changed since it was created.
+    */
+   void
+   setUpNeighborCommunicator();
+
+   /*!
+    * @brief Pack the outgoing messages and start the neighborhood
+    * collective exchanging them.
+    */
+   void
+   beginNeighborCommunication();
+
+   /*!
+    * @brief Complete the neighborhood collective and unpack the
+    * incoming messages.
+    */
+   void
+   finalizeNeighborCommunication();
+
+   /*!
+    * @brief Whether messages between processes of the same node go
+    * through shared memory.
+    */
+   bool
+   usingSharedMemory() const
+   {
+      return d_use_shared_memory &&
+             !usingNeighborCollective() &&
+             SharedMemoryWindow::isSupported() &&
+             d_mpi.getSize() > 1;
+   }
+
+   /*!
+    * @brief Find the node communicator and move the transactions with
+    * processes of the node to d_node_send_sets and d_node_recv_sets,
+    * if not done yet, then allocate the window for the communication.
+    */
+   void
+   setUpSharedMemoryTransport();
+
+   /*!
+    * @brief Move the node transactions back to d_send_sets and
+    * d_recv_sets, and drop the node communicator.
+    *
+    * This is local to the process.
+    *
+    * @pre !d_node_window.isAllocated()
+    */
+   void
+   tearDownSharedMemoryTransport();
+
+   /*!
+    * @brief Return the size of the local buffer needed for the
+    * messages to the processes of the node.
+    */
+   size_t
+   getNodeBufferSize() const;
+
+   /*!
+    * @brief Pack the messages for the processes of the node into the
+    * local buffer of the window.
+    */
+   void
+   packNodeMessages();
+
+   /*!
+    * @brief Make the packed messages visible to the node, unpack the
+    * messages from the processes of the node, then release their
+    * buffers.
+    */
+   void
+   unpackNodeMessages();
+
+   /*!
+    * @brief Return the first message data length to use for a message
+    * to or from the given peer, given the lengths learned for the
+    * direction of the message.
+    */
+   size_t
+   getFirstDataLength(
+      const std::map<int, size_t>& learned_lengths,
+      int peer_rank) const
+   {
+      if (d_learn_message_lengths) {
+         std::map<int, size_t>::const_iterator li =
+            learned_lengths.find(peer_rank);
+         if (li != learned_lengths.end() &&
+             li->second > d_first_message_length) {
+            return li->second;
+         }
+      }
+      return d_first_message_length;
+   }
+
    void
    processCompletedCommunications();
    void
@@ -328,6 +668,15 @@ private:
       getAllTimers(s_default_timer_prefix, timers);
    }
 
+   /*!
+    * @brief Free the graph and node communicators shared by the
+    * schedules.
+    *
+    * Only called by StartupShutdownManager.
+    */
+   static void
+   finalizeCallback();
+
    /*!
     * @brief Read input data from input database and initialize class members.
     */
@@ -344,6 +693,26 @@ private:
    TransactionSets d_send_sets;
    TransactionSets d_recv_sets;
 
+   /*
+    * @brief Return the sets holding the transactions sent to or
+    * received from a peer: the node sets if the peer is in
+    * d_node_ranks.
+    */
+   TransactionSets&
+   getSendSets(
+      int peer_rank)
+   {
+      return d_node_ranks.find(peer_rank) == d_node_ranks.end() ?
+             d_send_sets : d_node_send_sets;
+   }
+   TransactionSets&
+   getRecvSets(
+      int peer_rank)
+   {
+      return d_node_ranks.find(peer_rank) == d_node_ranks.end() ?
+             d_recv_sets : d_node_recv_sets;
+   }
+
    /*
     * @brief Transactions where the source and destination are the
     * local process.
@@ -365,6 +734,11 @@ private:
     * completion.
     */
    AsyncCommStage d_com_stage;
+   /*!
+    * @brief Whether each outgoing message (indexed like the send part
+    * of d_coms) has been posted in the current communication.
+    */
+   std::vector<bool> d_send_posted;
 
    //@}
 
@@ -400,6 +774,144 @@ private:
     */
    bool d_unpack_in_deterministic_order;
 
+   /*!
+    * @brief Whether to learn the message length of each peer.
+    *
+    * @see setLearnMessageLengths()
+    */
+   bool d_learn_message_lengths;
+
+   /*!
+    * @brief Length of the last message sent to each peer rank.
+    */
+   std::map<int, size_t> d_learned_send_lengths;
+
+   /*!
+    * @brief Length of the last message received from each peer rank.
+    */
+   std::map<int, size_t> d_learned_recv_lengths;
+
+   //@{ @name Neighborhood collective communication
+
+   /*!
+    * @brief Whether to exchange messages with a neighborhood
+    * collective.
+    *
+    * @see setUseNeighborCollective()
+    */
+   bool d_use_neighbor_collective;
+
+   /*!
+    * @brief Distributed graph communicator of the peers, or
+    * MPI_COMM_NULL before the first neighborhood communication.  It
+    * belongs to s_neighbor_graphs.
+    */
+   SAMRAI_MPI d_neighbor_mpi;
+
+   /*!
+    * @brief Ranks sending to and receiving from the local process in
+    * d_neighbor_mpi, in the order of d_recv_sets and d_send_sets.
+    */
+   std::vector<int> d_neighbor_sources;
+   std::vector<int> d_neighbor_destinations;
+
+   /*!
+    * @brief Whether a receiver on some process cannot compute its
+    * message lengths, so that the lengths must be exchanged.
+    */
+   bool d_neighbor_exchange_lengths;
+
+   /*!
+    * @brief Buffer holding the outgoing messages, one after the other.
+    */
+   std::shared_ptr<MessageStream> d_neighbor_send_stream;
+
+   /*!
+    * @brief Buffer receiving the incoming messages, one after the other.
+    */
+   std::vector<char> d_neighbor_recv_buffer;
+
+   /*!
+    * @brief Byte counts and displacements of the messages in the
+    * buffers.
+    */
+   std::vector<int> d_neighbor_send_counts;
+   std::vector<int> d_neighbor_send_displs;
+   std::vector<int> d_neighbor_recv_counts;
+   std::vector<int> d_neighbor_recv_displs;
+
+   /*!
+    * @brief Request of the pending neighborhood collective.
+    */
+   SAMRAI_MPI::Request d_neighbor_request;
+
+   /*!
+    * @brief Whether a neighborhood collective is pending.
+    */
+   bool d_neighbor_pending;
+
+   //@}
+
+   //@{ @name Shared memory communication within compute nodes
+
+   /*!
+    * @brief Whether to exchange messages within nodes through shared
+    * memory.
+    *
+    * @see setUseSharedMemory()
+    */
+   bool d_use_shared_memory;
+
+   /*!
+    * @brief Processes of d_mpi on the local node, or MPI_COMM_NULL
+    * before the first shared memory communication.  It belongs to
+    * s_node_groups.
+    */
+   SAMRAI_MPI d_node_mpi;
+
+   /*!
+    * @brief Rank in d_node_mpi of each process of d_mpi on the local
+    * node, other than the local process.
+    */
+   std::map<int, int> d_node_ranks;
+
+   /*!
+    * @brief Transactions with the processes of d_node_ranks.
+    */
+   TransactionSets d_node_send_sets;
+   TransactionSets d_node_recv_sets;
+
+   /*!
+    * @brief Buffers of the processes of the node.
+    *
+    * Each buffer starts with a directory: the number of messages, then
+    * the destination rank in d_mpi, offset and length of each message,
+    * as size_t.  The messages follow.
+    *
+    * The window is only allocated during a communication, whose end
+    * is the point where all processes of the node free it.
+    */
+   SharedMemoryWindow d_node_window;
+
+   /*!
+    * @brief Size of the local buffer at the end of the last
+    * communication, from which the next one starts.
+    */
+   size_t d_node_buffer_bytes;
+
+   /*!
+    * @brief Whether the messages of the current communication have
+    * been packed into the window.
+    */
+   bool d_node_packed;
+
+   /*!
+    * @brief Whether a shared memory communication is pending.
+    */
+   bool d_node_pending;
+
+   //@}
+
    static const int s_default_first_tag;
    static const int s_default_second_tag;
    static const size_t s_default_first_message_length;
@@ -439,6 +951,77 @@ private:
 
    static char s_ignore_external_timer_prefix;
 
+   /*!
+    * @brief Default of d_learn_message_lengths, from the input
+    * parameter DEV_learn_message_lengths.
+    */
+   static char s_learn_message_lengths;
+
+   /*!
+    * @brief Default of d_use_neighbor_collective, from the input
+    * parameter use_neighbor_collective.
+    */
+   static bool s_use_neighbor_collective;
+
+   /*!
+    * @brief Default of d_use_shared_memory, from the input parameter
+    * use_shared_memory.
+    */
+   static bool s_use_shared_memory;
+
+   /*!
+    * @brief Distributed graph communicators made over one communicator.
+    */
+   struct NeighborGraphs {
+      /*!
+       * @brief The graph communicators, in the order they were made,
+       * which is the same on all processes of the communicator.
+       */
+      std::vector<SAMRAI_MPI> graphs;
+
+      /*!
+       * @brief Index in graphs of the last graph communicator made
+       * with the given sources and destinations of the local process.
+       */
+      std::map<std::pair<std::vector<int>, std::vector<int> >, int> index;
+   };
+
+   /*!
+    * @brief Graph communicators shared by the schedules, by the
+    * communicator they were made over.
+    *
+    * A schedule reuses a graph communicator only if all processes find
+    * the same one for their peers; otherwise it makes a new one.
+    */
+   static std::map<SAMRAI_MPI::Comm, NeighborGraphs> s_neighbor_graphs;
+
+   /*!
+    * @brief Processes of a communicator on the local node.
+    */
+   struct NodeGroup {
+      explicit NodeGroup(
+         const SAMRAI_MPI& node_mpi):
+         mpi(node_mpi)
+      {
+      }
+
+      /*!
+       * @brief Communicator of the processes on the local node.
+       */
+      SAMRAI_MPI mpi;
+
+      /*!
+       * @brief Rank in the parent communicator of each process of mpi.
+       */
+      std::vector<int> mpi_ranks;
+   };
+
+   /*!
+    * @brief Node communicators shared by the schedules, by the
+    * communicator they were split from.
+    */
+   static std::map<SAMRAI_MPI::Comm, NodeGroup> s_node_groups;
+
    /*!
     * @brief Structure of timers in s_static_timers, matching this
     * object's timer prefix.
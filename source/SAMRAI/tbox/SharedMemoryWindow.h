@@ -0,0 +1,178 @@
+/*************************************************************************
+ *
+ * This file is part of the SAMRAI distribution.  For full copyright
+ * information, see COPYRIGHT and LICENSE.
+ *
+ * Copyright:     (c) 1997-2017 Lawrence Livermore National Security, LLC
+ * Description:   Buffers shared by the processes of a compute node
+ *
+ ************************************************************************/
+
+#ifndef included_tbox_SharedMemoryWindow
+#define included_tbox_SharedMemoryWindow
+
+#include "SAMRAI/SAMRAI_config.h"
+
+#include "SAMRAI/tbox/SAMRAI_MPI.h"
+#include "SAMRAI/tbox/Utilities.h"
+
+#include <vector>
+
+namespace SAMRAI {
+namespace tbox {
+
+/*!
+ * @brief Class SharedMemoryWindow gives each process of a compute node
+ * a buffer that the other processes of the node can read directly.
+ *
+ * The buffers are an MPI-3 shared memory window over a communicator
+ * holding processes that share memory, such as one made by
+ * SAMRAI_MPI::splitSharedMemoryCommunicator().  A process writes into
+ * its own buffer, then all processes call fence(), after which each can
+ * read the buffer of any other process until the next fence().
+ *
+ * allocate(), fence() and deallocate() are collective over the
+ * communicator of the window.
+ *
+ * Without MPI-3 shared memory (see isSupported()), the window may only
+ * be allocated over a communicator of one process, and its buffer is
+ * ordinary memory.
+ */
+
+class SharedMemoryWindow
+{
+public:
+   /*!
+    * @brief Constructor for a window with no buffers.
+    */
+   SharedMemoryWindow();
+
+   /*!
+    * @brief Destructor deallocates the window.
+    */
+   ~SharedMemoryWindow();
+
+   /*!
+    * @brief Whether SAMRAI is using MPI and the MPI library has MPI-3
+    * shared memory windows.
+    */
+   static bool
+   isSupported()
+   {
+#if defined(HAVE_MPI) && MPI_VERSION >= 3
+      return SAMRAI_MPI::usingMPI();
+
+#else
+      return false;
+
+#endif
+   }
+
+   /*!
+    * @brief Allocate the buffers, replacing any existing ones.
+    *
+    * @param[in] node_mpi  Processes sharing memory.  It must stay valid
+    *                      as long as the window is allocated.
+    * @param[in] num_bytes Size of the buffer of the local process,
+    *                      which is rounded up to a multiple of 64 bytes.
+    *
+    * @pre isSupported() || node_mpi.getSize() == 1
+    */
+   void
+   allocate(
+      const SAMRAI_MPI& node_mpi,
+      size_t num_bytes);
+
+   /*!
+    * @brief Free the buffers.
+    */
+   void
+   deallocate();
+
+   /*!
+    * @brief Whether the buffers are allocated.
+    */
+   bool
+   isAllocated() const
+   {
+      return d_allocated;
+   }
+
+   /*!
+    * @brief Complete the writes into the buffers and make them visible
+    * to all processes of the window.
+    *
+    * @pre isAllocated()
+    */
+   void
+   fence();
+
+   /*!
+    * @brief Return the size of the buffer of a process.
+    *
+    * @param[in] node_rank  Rank of the process in the window's
+    *                       communicator.
+    *
+    * @pre isAllocated()
+    */
+   size_t
+   getSize(
+      int node_rank) const
+   {
+      TBOX_ASSERT(isAllocated());
+      TBOX_ASSERT(node_rank >= 0 &&
+         node_rank < static_cast<int>(d_sizes.size()));
+      return d_sizes[node_rank];
+   }
+
+   /*!
+    * @brief Return the buffer of a process.
+    *
+    * @param[in] node_rank  Rank of the process in the window's
+    *                       communicator.
+    *
+    * @pre isAllocated()
+    */
+   char *
+   getBuffer(
+      int node_rank) const
+   {
+      TBOX_ASSERT(isAllocated());
+      TBOX_ASSERT(node_rank >= 0 &&
+         node_rank < static_cast<int>(d_buffers.size()));
+      return d_buffers[node_rank];
+   }
+
+private:
+   // Unimplemented copy constructor.
+   SharedMemoryWindow(
+      const SharedMemoryWindow& other);
+
+   // Unimplemented assignment operator.
+   SharedMemoryWindow&
+   operator = (
+      const SharedMemoryWindow& rhs);
+
+   bool d_allocated;
+
+   /*!
+    * @brief Buffer and buffer size of each process of the window.
+    */
+   std::vector<char *> d_buffers;
+   std::vector<size_t> d_sizes;
+
+#if defined(HAVE_MPI) && MPI_VERSION >= 3
+   MPI_Win d_win;
+#endif
+
+   /*!
+    * @brief Buffer of the local process when the window is not an MPI
+    * window.
+    */
+   std::vector<char> d_local_buffer;
+};
+
+}
+}
+
+#endif
@@ -94,6 +94,12 @@ namespace tbox {
  *       timers themselves are not affecting the performance of your
  *       calculation.
  *
+ *    - \b    print_memory
+ *       Prints the memory accounting of MemoryAccountant after the timers:
+ *       the memory used by each category of library objects on each level,
+ *       with its high-water mark and its minimum, average and maximum over
+ *       the processors.
+ *
  *    - \b    print_threshold
  *       Timers that use up less than (<EM>print_threshold</EM>) percent of
  *       the overall run time are not printed.  This can be a convenient
@@ -204,6 +210,14 @@ namespace tbox {
  *     <td>Not written to restart.  Value in input db used.</td>
  *   </tr>
  *   <tr>
+ *     <td>print_memory</td>
+ *     <td>bool</td>
+ *     <td>FALSE</td>
+ *     <td>TRUE, FALSE</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
  *     <td>print_threshold</td>
  *     <td>double</td>
  *     <td>0.25</td>
@@ -324,7 +338,9 @@ public:
    resetAllTimers();
 
    /*!
-    * Print the timing statistics to the specified output stream.
+    * Print the timing statistics to the specified output stream.  If the
+    * print_memory input parameter is TRUE, the memory accounting of
+    * MemoryAccountant is printed too, and this method is collective.
     */
    void
    print(
@@ -673,6 +689,12 @@ private:
    bool d_print_concurrent;
    bool d_print_timer_overhead;
 
+   /*
+    * Print the memory accounting of MemoryAccountant.
+    * Default:  d_print_memory=false;
+    */
+   bool d_print_memory;
+
    /*
     * Internal value used to set and grow arrays for storing
     * timers.
@@ -17,6 +17,7 @@
 #include "SAMRAI/hier/ComponentSelector.h"
 #include "SAMRAI/hier/Connector.h"
 #include "SAMRAI/hier/PatchLevel.h"
+#include "SAMRAI/tbox/MemoryAccount.h"
 #include "SAMRAI/tbox/Schedule.h"
 #include "SAMRAI/tbox/Timer.h"
 #include "SAMRAI/xfer/CoarsenClasses.h"
@@ -26,7 +27,9 @@
 #include "SAMRAI/xfer/CoarsenTransactionFactory.h"
 
 #include <iostream>
+#include <map>
 #include <memory>
+#include <vector>
 
 namespace SAMRAI {
 namespace xfer {
@@ -178,6 +181,31 @@ public:
    setDeterministicUnpackOrderingFlag(
       bool flag);
 
+   /*!
+    * @brief Set whether coarsenData() pipelines coarsening with
+    * communication.
+    *
+    * In pipelined mode, receives are posted before any coarsening is
+    * done and the message to each destination process is packed and
+    * sent as soon as the last local source patch contributing to it
+    * has been coarsened.  Incoming messages are unpacked in arrival
+    * order (unless deterministic ordering is set) while the local
+    * copies complete.  This hides communication latency behind the
+    * coarsening work.  The results are identical to the non-pipelined
+    * mode.
+    *
+    * The default is taken from the "pipeline_coarsening" entry of the
+    * "CoarsenSchedule" input database, which is false if not given.
+    *
+    * @param [in] flag
+    */
+   void
+   setPipelinedCoarsening(
+      bool flag)
+   {
+      d_pipeline_coarsening = flag;
+   }
+
    /*!
     * @brief Static function to set box intersection algorithm to use during
     * schedule construction for all CoarsenSchedule objects.
@@ -206,6 +234,12 @@ public:
       std::ostream& stream) const;
 
 private:
+   /*
+    * ScheduleGroup runs the phases of coarsenData() for several
+    * schedules with their communication aggregated.
+    */
+   friend class ScheduleGroup;
+
    CoarsenSchedule(
       const CoarsenSchedule&);              // not implemented
    CoarsenSchedule&
@@ -313,10 +347,31 @@ private:
     * @param[in] patch_strategy  Provides interface for user-defined functions
     *                            that may be used for coarsening.  Can be
     *                            null if no user-defined functions are needed.
+    * @param[in] post_sends      Post each outgoing message of d_schedule as
+    *                            soon as all of its local source patches are
+    *                            coarsened.  Requires receives to have been
+    *                            posted by d_schedule->beginReceives().
     */
    void
    coarsenSourceData(
-      CoarsenPatchStrategy* patch_strategy) const;
+      CoarsenPatchStrategy* patch_strategy,
+      bool post_sends = false) const;
+
+   /*!
+    * @brief Allocate the source data on the temporary coarse level and,
+    * if required, fill it from the coarse level before coarsening.
+    */
+   void
+   allocateSourceData() const;
+
+   /*!
+    * @brief Deallocate the source data on the temporary coarse level.
+    */
+   void
+   deallocateSourceData() const
+   {
+      d_temp_crse_level->deallocatePatchData(d_sources);
+   }
 
    /*!
     * @brief Calculate the maximum ghost cell width to grow boxes to check
@@ -425,6 +480,11 @@ private:
     */
    static bool s_read_static_input;
 
+   /*!
+    * @brief Default for d_pipeline_coarsening, from input.
+    */
+   static bool s_pipeline_coarsening;
+
    /*!
     * @brief Structures that store coarsen data items.
     */
@@ -482,6 +542,26 @@ private:
     */
    std::shared_ptr<tbox::Schedule> d_schedule;
 
+   /*!
+    * @brief Whether coarsenData() pipelines coarsening with
+    * communication.
+    *
+    * @see setPipelinedCoarsening()
+    */
+   bool d_pipeline_coarsening;
+
+   /*!
+    * @brief Remote destination ranks that each local temporary patch
+    * sends data to through d_schedule.
+    */
+   std::map<hier::GlobalId, std::vector<int> > d_pipeline_send_peers;
+
+   /*!
+    * @brief Number of local temporary patches contributing to the
+    * message to each remote destination rank.
+    */
+   std::map<int, int> d_pipeline_patches_per_peer;
+
    /*!
     * @brief Boolean indicating whether source data on the coarse temporary
     * level must be filled before coarsening operations (see comments for class
@@ -501,6 +581,17 @@ private:
     */
    std::shared_ptr<RefineSchedule> d_precoarsen_refine_schedule;
 
+   /*!
+    * @brief Footprint of the transactions of d_schedule, accounted on the
+    * coarse level.
+    */
+   tbox::MemoryAccount d_memory_account;
+
+   /*!
+    * @brief Memory category of CoarsenSchedules.
+    */
+   static int s_memory_category;
+
    //@{
 
    /*!
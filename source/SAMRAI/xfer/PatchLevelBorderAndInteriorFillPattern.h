@@ -136,6 +136,15 @@ public:
    bool
    fillingEnhancedConnectivityOnly() const;
 
+   /*!
+    * @brief Return true if @c other is also a PatchLevelBorderAndInteriorFillPattern.
+    *
+    * This fill pattern has no configurable state.
+    */
+   bool
+   fillsSameBoxesAs(
+      const PatchLevelFillPattern& other) const;
+
 private:
    PatchLevelBorderAndInteriorFillPattern(
       const PatchLevelBorderAndInteriorFillPattern&);    // not implemented
@@ -127,6 +127,15 @@ public:
    bool
    fillingEnhancedConnectivityOnly() const;
 
+   /*!
+    * @brief Return true if @c other is also a PatchLevelBorderFillPattern.
+    *
+    * This fill pattern has no configurable state.
+    */
+   bool
+   fillsSameBoxesAs(
+      const PatchLevelFillPattern& other) const;
+
 private:
    PatchLevelBorderFillPattern(
       const PatchLevelBorderFillPattern&);            // not implemented
@@ -136,6 +136,15 @@ public:
    bool
    fillingEnhancedConnectivityOnly() const;
 
+   /*!
+    * @brief Return true if @c other is also a PatchLevelEnhancedFillPattern.
+    *
+    * This fill pattern has no configurable state.
+    */
+   bool
+   fillsSameBoxesAs(
+      const PatchLevelFillPattern& other) const;
+
 private:
    PatchLevelEnhancedFillPattern(
       const PatchLevelEnhancedFillPattern&);           // not implemented
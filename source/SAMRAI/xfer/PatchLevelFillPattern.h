@@ -180,6 +180,22 @@ public:
    virtual bool
    fillingEnhancedConnectivityOnly() const = 0;
 
+   /*!
+    * @brief Return whether this fill pattern computes the same fill boxes
+    * as another one for any destination level.
+    *
+    * RefineAlgorithm uses this to decide whether a cached schedule that
+    * was created with @c other may be returned for this fill pattern.
+    * The default implementation returns true only if @c other is this
+    * object.  Implementations without configurable state may override
+    * it to accept any object of the same type.
+    *
+    * @param[in] other
+    */
+   virtual bool
+   fillsSameBoxesAs(
+      const PatchLevelFillPattern& other) const;
+
 private:
    PatchLevelFillPattern(
       const PatchLevelFillPattern&);                       // not implemented
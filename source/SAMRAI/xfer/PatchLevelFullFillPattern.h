@@ -116,6 +116,15 @@ public:
    bool
    fillingEnhancedConnectivityOnly() const;
 
+   /*!
+    * @brief Return true if @c other is also a PatchLevelFullFillPattern.
+    *
+    * This fill pattern has no configurable state.
+    */
+   bool
+   fillsSameBoxesAs(
+      const PatchLevelFillPattern& other) const;
+
 private:
    PatchLevelFullFillPattern(
       const PatchLevelFullFillPattern&);             // not implemented
@@ -133,6 +133,15 @@ public:
    bool
    fillingEnhancedConnectivityOnly() const;
 
+   /*!
+    * @brief Return true if @c other is also a PatchLevelInteriorFillPattern.
+    *
+    * This fill pattern has no configurable state.
+    */
+   bool
+   fillsSameBoxesAs(
+      const PatchLevelFillPattern& other) const;
+
 private:
    PatchLevelInteriorFillPattern(
       const PatchLevelInteriorFillPattern&);         // not implemented
@@ -25,7 +25,9 @@
 #include "SAMRAI/hier/PatchHierarchy.h"
 #include "SAMRAI/hier/PatchLevel.h"
 
+#include <list>
 #include <memory>
+#include <vector>
 
 namespace SAMRAI {
 namespace xfer {
@@ -112,6 +114,26 @@ namespace xfer {
  * as long as the patches involved in the communication process do not change;
  * thus, they can be used for multiple data communication cycles.
  *
+ * Schedule construction is expensive.  If schedule caching is turned on
+ * with setScheduleCaching(), createSchedule() returns a previously created
+ * schedule, shared with its earlier callers, when called again with the
+ * same levels, hierarchy, patch strategy, transaction factory and time
+ * refinement flag and an equivalent fill pattern (see
+ * PatchLevelFillPattern::fillsSameBoxesAs()).  The cache holds its
+ * schedules, so a schedule is reused even after every caller has released
+ * it.  It holds at most getScheduleCacheLimit() schedules and drops the
+ * least recently used one when full.  A cached schedule is dropped at the
+ * next createSchedule() call after any BoxLevel it depends on changes (see
+ * BoxLevel::getBoxLevelHandle()), which also clears the Connectors of the
+ * BoxLevel, or after a hierarchy level it depends on or its destination
+ * level, if that was in the hierarchy, is replaced, e.g. by a regrid.
+ * Until then it keeps its levels alive.  Schedules created without a
+ * hierarchy are not dropped when their levels are replaced in one; they
+ * are released only when they become the least recently used or by
+ * clearScheduleCache().  Shared schedules must not be reset with
+ * resetSchedule() and must not have fills from more than one caller
+ * pending at once.
+ *
  * @see RefineSchedule
  * @see RefinePatchStrategy
  * @see RefineClasses
@@ -673,7 +695,147 @@ public:
    printClassData(
       std::ostream& stream) const;
 
+   /*!
+    * @brief Set whether createSchedule() reuses previously created
+    * schedules.
+    *
+    * Caching is off by default.  Turning it off clears the cache.
+    *
+    * @param[in] flag
+    */
+   void
+   setScheduleCaching(
+      bool flag)
+   {
+      d_use_schedule_cache = flag;
+      if (!flag) {
+         clearScheduleCache();
+      }
+   }
+
+   /*!
+    * @brief Set the maximum number of schedules the cache holds.
+    *
+    * The least recently used schedules are released if the cache holds
+    * more.  The default is DEFAULT_SCHEDULE_CACHE_LIMIT.
+    *
+    * @param[in] max_schedules
+    *
+    * @pre max_schedules > 0
+    */
+   void
+   setScheduleCacheLimit(
+      size_t max_schedules);
+
+   /*!
+    * @brief Return the maximum number of schedules the cache holds.
+    */
+   size_t
+   getScheduleCacheLimit() const
+   {
+      return d_schedule_cache_limit;
+   }
+
+   /*!
+    * @brief Release all cached schedules.
+    */
+   void
+   clearScheduleCache()
+   {
+      d_schedule_cache.clear();
+   }
+
+   /*!
+    * @brief Return the number of schedules in the cache, including ones
+    * not yet found to be invalid.
+    */
+   size_t
+   getScheduleCacheSize() const
+   {
+      return d_schedule_cache.size();
+   }
+
+   /*!
+    * @brief Default maximum number of cached schedules.
+    */
+   static const size_t DEFAULT_SCHEDULE_CACHE_LIMIT = 32;
+
 private:
+   /*!
+    * @brief Description of a createSchedule() call and the schedule it
+    * created, for schedule caching.
+    *
+    * The schedule and the objects it holds anyway are referenced
+    * strongly.  The hierarchy and its levels, which the schedule does not
+    * necessarily hold, are referenced weakly and compared by owner, so an
+    * object that merely reuses the address of a destroyed one does not
+    * match.
+    */
+   struct CachedSchedule {
+      std::shared_ptr<RefineSchedule> d_schedule;
+      std::shared_ptr<PatchLevelFillPattern> d_fill_pattern;
+      std::shared_ptr<hier::PatchLevel> d_dst_level;
+      std::shared_ptr<hier::PatchLevel> d_src_level;
+      int d_next_coarser_level;
+      std::weak_ptr<hier::PatchHierarchy> d_hierarchy;
+      const RefinePatchStrategy* d_patch_strategy;
+      bool d_use_time_refinement;
+      std::shared_ptr<RefineTransactionFactory> d_transaction_factory;
+      //! Levels 0 through d_next_coarser_level of d_hierarchy.
+      std::vector<std::weak_ptr<hier::PatchLevel> > d_hierarchy_levels;
+      //! Number of d_dst_level in d_hierarchy, or -1 if not in it.
+      int d_dst_level_number;
+      //! Handles to the BoxLevels of all levels above.
+      std::vector<std::shared_ptr<hier::BoxLevelHandle> > d_handles;
+   };
+
+   /*!
+    * @brief Return the cached schedule for the given createSchedule()
+    * arguments, or a null pointer if there is none.
+    *
+    * Invalid cache entries are removed, and the entry found becomes
+    * the most recently used one.
+    */
+   std::shared_ptr<RefineSchedule>
+   findCachedSchedule(
+      const std::shared_ptr<PatchLevelFillPattern>& fill_pattern,
+      const std::shared_ptr<hier::PatchLevel>& dst_level,
+      const std::shared_ptr<hier::PatchLevel>& src_level,
+      int next_coarser_level,
+      const std::shared_ptr<hier::PatchHierarchy>& hierarchy,
+      const RefinePatchStrategy* patch_strategy,
+      bool use_time_refinement,
+      const std::shared_ptr<RefineTransactionFactory>& transaction_factory);
+
+   /*!
+    * @brief Add a newly created schedule to the cache, if caching is on,
+    * releasing the least recently used schedule if the cache is full.
+    */
+   void
+   cacheSchedule(
+      const std::shared_ptr<RefineSchedule>& schedule,
+      const std::shared_ptr<PatchLevelFillPattern>& fill_pattern,
+      const std::shared_ptr<hier::PatchLevel>& dst_level,
+      const std::shared_ptr<hier::PatchLevel>& src_level,
+      int next_coarser_level,
+      const std::shared_ptr<hier::PatchHierarchy>& hierarchy,
+      const RefinePatchStrategy* patch_strategy,
+      bool use_time_refinement,
+      const std::shared_ptr<RefineTransactionFactory>& transaction_factory);
+
+   /*!
+    * @brief Whether a cache entry is still usable.
+    */
+   bool
+   isCacheEntryValid(
+      const CachedSchedule& entry) const;
+
+   /*!
+    * @brief Remove invalid entries from the cache.
+    */
+   void
+   purgeScheduleCache();
+
    RefineAlgorithm(
       const RefineAlgorithm&);                  // not implemented
    RefineAlgorithm&
@@ -690,6 +852,21 @@ private:
     */
    bool d_schedule_created;
 
+   /*!
+    * Whether createSchedule() reuses cached schedules.
+    */
+   bool d_use_schedule_cache;
+
+   /*!
+    * Maximum number of schedules in d_schedule_cache.
+    */
+   size_t d_schedule_cache_limit;
+
+   /*!
+    * Schedules created while caching is on, least recently used first.
+    */
+   std::list<CachedSchedule> d_schedule_cache;
+
 };
 
 }
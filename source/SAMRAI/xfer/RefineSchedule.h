@@ -22,11 +22,13 @@
 #include "SAMRAI/hier/IntVector.h"
 #include "SAMRAI/hier/PatchHierarchy.h"
 #include "SAMRAI/hier/PatchLevel.h"
+#include "SAMRAI/tbox/MemoryAccount.h"
 #include "SAMRAI/tbox/Schedule.h"
 #include "SAMRAI/tbox/Timer.h"
 
 #include <iostream>
 #include <memory>
+#include <vector>
 
 namespace SAMRAI {
 namespace xfer {
@@ -249,6 +251,75 @@ public:
       double fill_time,
       bool do_physical_boundary_fill = true) const;
 
+   /*!
+    * @brief Begin a split-phase execution of the schedule.
+    *
+    * Everything fillData() does before communicating data from the
+    * source level is done here, including any filling from coarser
+    * levels.  The communication from the source level is then started
+    * but not completed.  The fill is completed by finalizeFillData(),
+    * and the caller may do unrelated work (including executing other
+    * schedules) between the two calls.
+    *
+    * The pending messages travel on the schedule's communicator with a
+    * pair of MPI tags reserved for split-phase fills, so that other
+    * schedules and algorithms may communicate on the communicator
+    * while the fill is pending.  Each pending fill holds its own pair,
+    * and the pair is released by finalizeFillData().  Like fillData(),
+    * this method must be called collectively, and the processes must
+    * begin and finalize their split-phase fills in the same order so
+    * that they choose the same pair.
+    *
+    * Until finalizeFillData() is called, the source data must not be
+    * modified and the destination data may not be accessed.
+    *
+    * @param[in] fill_time                 Time for filling operation.
+    * @param[in] do_physical_boundary_fill See fillData().
+    *
+    * @pre !isFillDataPending()
+    */
+   void
+   beginFillData(
+      double fill_time,
+      bool do_physical_boundary_fill = true) const;
+
+   /*!
+    * @brief Complete a fill started by beginFillData().
+    *
+    * @pre isFillDataPending()
+    */
+   void
+   finalizeFillData() const;
+
+   /*!
+    * @brief Return whether a fill started by beginFillData() has not
+    * yet been completed by finalizeFillData().
+    */
+   bool
+   isFillDataPending() const
+   {
+      return d_fill_pending;
+   }
+
+   /*!
+    * @brief Set the MPI communicator used to execute the schedule.
+    *
+    * By default the schedule communicates on the SAMRAI world
+    * communicator and fillData() must be called by every process in
+    * it.  A schedule whose transactions involve only a subset of the
+    * processes may be given a communicator of that subset, provided
+    * each process in the subset has the same rank in it.  Only those
+    * processes then call fillData().  The communicator also applies to
+    * the schedules filling from coarser levels.
+    *
+    * @param[in] mpi
+    *
+    * @pre !isFillDataPending()
+    */
+   void
+   setMPI(
+      const tbox::SAMRAI_MPI& mpi);
+
    /*!
     * @brief Return refine equivalence classes.
     *
@@ -323,6 +394,12 @@ public:
       std::ostream& stream) const;
 
 private:
+   /*
+    * ScheduleGroup runs the phases of fillData() for several schedules
+    * with their communication aggregated.
+    */
+   friend class ScheduleGroup;
+
    /*
     * Static integer constant describing the largest possible ghost cell width.
     */
@@ -342,6 +419,18 @@ private:
    static void
    initializeCallback();
 
+   /*!
+    * @brief Set the footprint of the transactions in the memory account.
+    */
+   void
+   updateMemoryAccount()
+   {
+      d_memory_account.setLevel(d_dst_level->getLevelNumber());
+      d_memory_account.setBytes(
+         d_coarse_priority_level_schedule->getMemoryFootprint()
+         + d_fine_priority_level_schedule->getMemoryFootprint());
+   }
+
    /*!
     * @brief Free static timers.
     *
@@ -513,6 +602,52 @@ private:
       double fill_time,
       bool do_physical_boundary_fill) const;
 
+   /*!
+    * @brief The part of recursiveFill() preceding the communication
+    * from the source level: fill from the coarse priority schedule and
+    * from coarser levels.
+    */
+   void
+   fillScratchFromCoarser(
+      double fill_time,
+      bool do_physical_boundary_fill) const;
+
+   /*!
+    * @brief The part of fillScratchFromCoarser() following the coarse
+    * priority communication: fill from coarser levels.
+    */
+   void
+   interpolateScratchFromCoarser(
+      double fill_time,
+      bool do_physical_boundary_fill) const;
+
+   /*!
+    * @brief The part of recursiveFill() following the communication
+    * from the source level: fill physical and singularity boundaries.
+    */
+   void
+   fillScratchBoundaries(
+      double fill_time,
+      bool do_physical_boundary_fill) const;
+
+   /*!
+    * @brief Set the data time and allocate the scratch space needed on
+    * the destination level by a fill.
+    *
+    * The allocated components are remembered in d_fill_allocate_vector
+    * and friends for copyAndDeallocateFillData().
+    */
+   void
+   allocateFillData(
+      double fill_time) const;
+
+   /*!
+    * @brief Copy scratch to destination and deallocate the space
+    * allocated by allocateFillData().
+    */
+   void
+   copyAndDeallocateFillData() const;
+
    /*!
     * @brief Fill the physical boundaries for each patch on d_dst_level.
     *
@@ -1324,6 +1459,47 @@ private:
    hier::ComponentSelector d_coarse_encon_encon_work_vector;
    bool d_internal_allocated;
 
+   //@{
+   /*!
+    * @name Components allocated by the fill in progress.
+    *
+    * Kept as members so that the allocation and deallocation can be
+    * separated by beginFillData() and finalizeFillData().
+    */
+   mutable hier::ComponentSelector d_fill_allocate_vector;
+   mutable hier::ComponentSelector d_fill_encon_allocate_vector;
+   mutable hier::ComponentSelector d_fill_nbr_fill_scratch_vector;
+   mutable hier::ComponentSelector d_fill_nbr_fill_dst_vector;
+   //@}
+
+   //@{
+   /*!
+    * @name State of a split-phase fill.
+    *
+    * @see beginFillData(), finalizeFillData()
+    */
+   mutable bool d_fill_pending;
+   mutable double d_pending_fill_time;
+   mutable bool d_pending_physical_boundary_fill;
+
+   /*!
+    * @brief Index of the pair of MPI tags held by the pending fill, or
+    * -1.
+    */
+   mutable int d_split_phase_slot;
+   //@}
+
+   /*!
+    * @brief Footprint of the transactions of this schedule, accounted on
+    * the destination level.  Recursive schedules account for their own.
+    */
+   tbox::MemoryAccount d_memory_account;
+
+   /*!
+    * @brief Memory category of RefineSchedules.
+    */
+   static int s_memory_category;
+
    /*!
     * @brief Shared debug checking flag.
     */
@@ -1340,6 +1516,26 @@ private:
     */
    static bool s_read_static_input;
 
+   //@{
+   /*!
+    * @name MPI tags of split-phase fills.
+    *
+    * Pending split-phase fills i use the tags
+    * s_split_phase_first_tag + 2 * i and s_split_phase_first_tag +
+    * 2 * i + 1, for i < s_max_split_phase_fills.  The tags are above
+    * those of the other SAMRAI communication and below the least upper
+    * bound of MPI tags guaranteed by the MPI standard, 32767.
+    */
+   static const int s_split_phase_first_tag = 32000;
+   static const int s_max_split_phase_fills = 64;
+
+   /*!
+    * @brief Whether each pair of split-phase tags is held by a pending
+    * fill.
+    */
+   static std::vector<bool> s_split_phase_slots;
+   //@}
+
    //@{
    /*!
     * @name Timer objects for performance measurement.
@@ -0,0 +1,290 @@
+/*************************************************************************
+ *
+ * This file is part of the SAMRAI distribution.  For full copyright
+ * information, see COPYRIGHT and LICENSE.
+ *
+ * Copyright:     (c) 1997-2017 Lawrence Livermore National Security, LLC
+ * Description:   Group of refine and coarsen schedules executed with
+ *                aggregated communication
+ *
+ ************************************************************************/
+
+#ifndef included_xfer_ScheduleGroup
+#define included_xfer_ScheduleGroup
+
+#include "SAMRAI/SAMRAI_config.h"
+
+#include "SAMRAI/tbox/Schedule.h"
+#include "SAMRAI/tbox/StartupShutdownManager.h"
+#include "SAMRAI/tbox/Timer.h"
+#include "SAMRAI/xfer/CoarsenSchedule.h"
+#include "SAMRAI/xfer/RefineSchedule.h"
+
+#include <memory>
+#include <vector>
+
+namespace SAMRAI {
+namespace xfer {
+
+/*!
+ * @brief Class ScheduleGroup executes several refine and coarsen
+ * schedules as a single communication phase.
+ *
+ * Executing schedules one after another costs one round of messages
+ * per schedule, even when the schedules exchange data between the
+ * same pairs of processes.  A ScheduleGroup packs the transactions of
+ * all of its schedules for a given peer process into one message,
+ * dividing the number of messages and the latency paid by up to the
+ * number of schedules in the group.
+ *
+ * execute() runs the phases of RefineSchedule::fillData() and
+ * CoarsenSchedule::coarsenData() for all schedules in lock step:
+ *
+ * -# Scratch space is allocated for every refine schedule and source
+ *    data is coarsened onto the temporary level of every coarsen
+ *    schedule.
+ * -# The coarse priority level communication of all refine schedules
+ *    is done in one aggregated communication.
+ * -# Each refine schedule fills from coarser levels.  These recursive
+ *    fills are done schedule by schedule.
+ * -# The fine priority level communication of all refine schedules and
+ *    the level communication of all coarsen schedules is done in one
+ *    aggregated communication.
+ * -# Each refine schedule fills physical boundaries and copies scratch
+ *    to destination data, and all temporary data is deallocated.
+ *
+ * @note Limitation: the phases are not ordered between schedules, so
+ * no schedule in a group may read data written by another schedule in
+ * the group.  For example, a refine schedule that fills ghosts of a
+ * coarse level must not be grouped with the coarsen schedule that
+ * writes the interior of that coarse level: the refine schedule sends
+ * its source data in the same message that carries the coarsened
+ * data, before that data has arrived.  Such dependent schedules must
+ * be executed in separate groups (or separately), in dependency
+ * order.  Typically the schedules in a group fill different variables
+ * or different levels.  The group cannot detect a violation; the
+ * result is silently stale data.
+ *
+ * The schedules must be added in the same order on all processes, and
+ * execute() must be called collectively.
+ *
+ * The aggregated communication schedules are built on the first
+ * execute() and reused by later ones.  They are rebuilt when the group
+ * changes (addRefineSchedule(), addCoarsenSchedule(), clear(),
+ * setDeterministicUnpackOrderingFlag()) and when a member schedule has
+ * regenerated its transactions.  The group holds references to its
+ * schedules; a schedule that is replaced by a new one (e.g. after a
+ * regrid) must be removed with clear() and the new one added.
+ *
+ * @see RefineSchedule
+ * @see CoarsenSchedule
+ */
+
+class ScheduleGroup
+{
+public:
+   /*!
+    * @brief Construct an empty group.
+    */
+   ScheduleGroup();
+
+   /*!
+    * @brief Destructor.
+    */
+   ~ScheduleGroup();
+
+   /*!
+    * @brief Add a refine schedule to the group.
+    *
+    * @param[in] schedule
+    * @param[in] do_physical_boundary_fill  Passed to the physical
+    *                                       boundary fill of the schedule,
+    *                                       as in RefineSchedule::fillData().
+    *
+    * The schedule must not read data written by another schedule in the
+    * group; see the class documentation.
+    *
+    * @pre schedule
+    * @pre !schedule->isFillDataPending()
+    */
+   void
+   addRefineSchedule(
+      const std::shared_ptr<RefineSchedule>& schedule,
+      bool do_physical_boundary_fill = true);
+
+   /*!
+    * @brief Add a coarsen schedule to the group.
+    *
+    * The data the schedule coarsens must not be read by another
+    * schedule in the group; see the class documentation.
+    *
+    * @param[in] schedule
+    *
+    * @pre schedule
+    */
+   void
+   addCoarsenSchedule(
+      const std::shared_ptr<CoarsenSchedule>& schedule);
+
+   /*!
+    * @brief Remove all schedules from the group.
+    */
+   void
+   clear();
+
+   /*!
+    * @brief Return the number of schedules in the group.
+    */
+   size_t
+   getNumberOfSchedules() const
+   {
+      return d_refine_schedules.size() + d_coarsen_schedules.size();
+   }
+
+   /*!
+    * @brief Execute all schedules in the group.
+    *
+    * This has the same effect as calling fillData(fill_time) for each
+    * refine schedule and coarsenData() for each coarsen schedule, but
+    * with the level communications of all schedules aggregated.
+    *
+    * @param[in] fill_time  Time at which refine schedules are filled.
+    */
+   void
+   execute(
+      double fill_time) const;
+
+   /*!
+    * @brief Set whether to unpack messages in a deterministic order.
+    *
+    * @param [in] flag
+    */
+   void
+   setDeterministicUnpackOrderingFlag(
+      bool flag)
+   {
+      d_unpack_in_deterministic_order = flag;
+      invalidateAggregates();
+   }
+
+private:
+   ScheduleGroup(
+      const ScheduleGroup&);            // not implemented
+   ScheduleGroup&
+   operator = (
+      const ScheduleGroup&);            // not implemented
+
+   /*!
+    * @brief Return an aggregated schedule for the given member
+    * schedules, building it only if the cached one is missing or was
+    * built from different members.
+    *
+    * @param[in,out] aggregate  Cached aggregated schedule.
+    * @param[in,out] built_from  Members the cached schedule was built
+    *                            from.
+    * @param[in] members  Current member schedules, in order.
+    */
+   tbox::Schedule&
+   getAggregate(
+      std::shared_ptr<tbox::Schedule>& aggregate,
+      std::vector<std::weak_ptr<tbox::Schedule> >& built_from,
+      const std::vector<std::shared_ptr<tbox::Schedule> >& members) const;
+
+   /*!
+    * @brief Build a schedule holding the transactions of the given
+    * schedules, in order.
+    */
+   std::shared_ptr<tbox::Schedule>
+   aggregateSchedules(
+      const std::vector<std::shared_ptr<tbox::Schedule> >& schedules) const;
+
+   /*!
+    * @brief Drop the cached aggregated schedules.
+    */
+   void
+   invalidateAggregates()
+   {
+      d_coarse_priority_aggregate.reset();
+      d_fine_priority_aggregate.reset();
+      d_coarse_priority_built_from.clear();
+      d_fine_priority_built_from.clear();
+   }
+
+   /*!
+    * @brief Set up things for the entire class.
+    *
+    * Only called by StartupShutdownManager.
+    */
+   static void
+   initializeCallback();
+
+   /*!
+    * Free static timers.
+    *
+    * Only called by StartupShutdownManager.
+    */
+   static void
+   finalizeCallback();
+
+   /*!
+    * @brief Refine schedules in the group, in the order added.
+    */
+   std::vector<std::shared_ptr<RefineSchedule> > d_refine_schedules;
+
+   /*!
+    * @brief Physical boundary fill flag of each refine schedule.
+    */
+   std::vector<bool> d_do_physical_boundary_fill;
+
+   /*!
+    * @brief Coarsen schedules in the group, in the order added.
+    */
+   std::vector<std::shared_ptr<CoarsenSchedule> > d_coarsen_schedules;
+
+   /*!
+    * @brief Whether to unpack messages in a deterministic order.
+    */
+   bool d_unpack_in_deterministic_order;
+
+   /*!
+    * @brief Cached aggregate of the coarse priority level schedules of
+    * the refine schedules.
+    */
+   mutable std::shared_ptr<tbox::Schedule> d_coarse_priority_aggregate;
+
+   /*!
+    * @brief Cached aggregate of the fine priority level schedules of
+    * the refine schedules and the schedules of the coarsen schedules.
+    */
+   mutable std::shared_ptr<tbox::Schedule> d_fine_priority_aggregate;
+
+   /*!
+    * @brief Member schedules d_coarse_priority_aggregate was built from.
+    *
+    * Weak references detect a member schedule that was regenerated
+    * without keeping the old one alive.
+    */
+   mutable std::vector<std::weak_ptr<tbox::Schedule> >
+   d_coarse_priority_built_from;
+
+   /*!
+    * @brief Member schedules d_fine_priority_aggregate was built from.
+    */
+   mutable std::vector<std::weak_ptr<tbox::Schedule> >
+   d_fine_priority_built_from;
+
+   /*!
+    * @name Timer objects for performance measurement.
+    */
+   static std::shared_ptr<tbox::Timer> t_execute;
+   static std::shared_ptr<tbox::Timer> t_aggregate;
+
+   static tbox::StartupShutdownManager::Handler
+      s_initialize_finalize_handler;
+
+};
+
+}
+}
+
+#endif
@@ -138,6 +138,8 @@ public:
     * -# Set boundary conditions
     * -# Specify Poisson equation parameters
     * -# Call solver
+    *
+    * @return Whether the solver converged.
     */
    int
    solvePoisson();
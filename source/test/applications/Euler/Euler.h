@@ -18,6 +18,7 @@
 #include "SAMRAI/appu/VisItDataWriter.h"
 #include "SAMRAI/hier/BoundaryBox.h"
 #include "SAMRAI/appu/BoundaryUtilityStrategy.h"
+#include "SAMRAI/appu/CartesianBoundaryFillPlan.h"
 #include "SAMRAI/hier/Box.h"
 #include "SAMRAI/geom/CartesianGridGeometry.h"
 #include "SAMRAI/pdat/CellVariable.h"
@@ -495,6 +496,12 @@ private:
    int d_workload_data_id;
    bool d_use_nonuniform_workload;
 
+   /*
+    * Tolerance, relative to the range of each patch, of the lossy
+    * compression of the plotted solution; zero for no compression.
+    */
+   double d_plot_compression_tolerance;
+
    /*
     * Euler solution state is represented by "primitive" variables,
     * density, velocity, and pressure.
@@ -602,6 +609,12 @@ private:
    std::vector<double> d_bdry_face_velocity; // Used in 3D only.
    std::vector<double> d_bdry_face_pressure; // Used in 3D only.
 
+   /*
+    * Physical boundary fill plans of the patches, built on the first
+    * boundary fill of each patch.
+    */
+   appu::CartesianBoundaryFillPlan::Cache d_bdry_fill_plans;
+
    /*
     * Refinement criteria parameters for gradient detector and
     * Richardson extrapolation.
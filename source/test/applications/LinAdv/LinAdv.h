@@ -14,7 +14,9 @@
 #include "SAMRAI/SAMRAI_config.h"
 
 #include "SAMRAI/appu/BoundaryUtilityStrategy.h"
+#include "SAMRAI/appu/CartesianBoundaryFillPlan.h"
 #include "SAMRAI/hier/Box.h"
+#include "SAMRAI/hier/BoxContainer.h"
 #include "SAMRAI/geom/CartesianGridGeometry.h"
 #include "SAMRAI/pdat/CellVariable.h"
 #include "SAMRAI/tbox/Database.h"
@@ -149,6 +151,16 @@ public:
       const bool initial_time,
       const double dt_time);
 
+   /**
+    * The numerical routines only write data on the patch they are given,
+    * so they may be called for several patches at once.
+    */
+   bool
+   patchRoutinesAreThreadSafe() const
+   {
+      return true;
+   }
+
    /**
     * Compute time integral of fluxes to be used in conservative difference
     * for patch integration.  When (dim == tbox::Dimension(3)), this function calls either
@@ -470,6 +482,14 @@ private:
     */
    double d_source;
    bool d_check_fluxes;
+
+   /**
+    * factor applied to the stable dt of patches touching the given
+    * boxes (level zero index space), for use in testing local time
+    * stepping
+    */
+   hier::BoxContainer d_dt_scale_boxes;
+   double d_dt_scale;
    
    /*
     *  Parameters for numerical method:
@@ -537,6 +557,12 @@ private:
    std::vector<double> d_bdry_edge_uval; // only for (dim == tbox::Dimension(2))
    std::vector<double> d_bdry_face_uval; // only for (dim == tbox::Dimension(3))
 
+   /*
+    * Physical boundary fill plans of the patches, built on the first
+    * boundary fill of each patch.
+    */
+   appu::CartesianBoundaryFillPlan::Cache d_bdry_fill_plans;
+
    /*
     * Input for Sine problem initialization
     */
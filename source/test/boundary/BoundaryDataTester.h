@@ -14,6 +14,7 @@
 #include "SAMRAI/SAMRAI_config.h"
 
 #include "SAMRAI/appu/BoundaryUtilityStrategy.h"
+#include "SAMRAI/appu/CartesianBoundaryFillPlan.h"
 #include "SAMRAI/geom/CartesianGridGeometry.h"
 #include "SAMRAI/xfer/RefinePatchStrategy.h"
 #include "SAMRAI/hier/Box.h"
@@ -200,6 +201,11 @@ private:
 
    std::vector<std::vector<double> > d_variable_bc_values;
 
+   /*
+    * Fill plans checked against the boundary utilities.
+    */
+   appu::CartesianBoundaryFillPlan::Cache d_fill_plans;
+
    int d_fail_count;
 
    /*
@@ -221,6 +227,17 @@ private:
    void
    postprocessBoundaryInput();
    void
+   fillBoundaryDataWithUtilities(
+      int iv,
+      const std::shared_ptr<pdat::CellData<double> >& cvdata,
+      const hier::Patch& patch,
+      const hier::IntVector& fill_gcw);
+   void
+   checkBoundaryFillPlan(
+      int iv,
+      const hier::Patch& patch,
+      const hier::IntVector& fill_gcw);
+   void
    checkBoundaryData(
       int btype,
       const hier::Patch& patch,
@@ -28,6 +28,7 @@
 #include "SAMRAI/xfer/RefineAlgorithm.h"
 #include "SAMRAI/xfer/RefinePatchStrategy.h"
 #include "SAMRAI/xfer/RefineSchedule.h"
+#include "SAMRAI/xfer/ScheduleGroup.h"
 #include "SAMRAI/mesh/StandardTagAndInitialize.h"
 #include "SAMRAI/mesh/StandardTagAndInitStrategy.h"
 #ifndef included_String
@@ -157,6 +158,45 @@ public:
    performCoarsenOperations(
       const int level_number);
 
+   /**
+    * Turn on schedule caching in the refine algorithms.  Schedules
+    * created again for unchanged levels are then checked to be the
+    * cached ones by verifyCommunicationResults().
+    */
+   void
+   setScheduleCaching(
+      bool flag);
+
+   /**
+    * Check that refine schedules released by their callers are still
+    * taken from the cache.  Then replace the coarsest level by a copy of
+    * itself, as a regrid producing the same boxes would, and check that
+    * the refine schedules are rebuilt rather than taken from the cache,
+    * that the cache does not keep the replaced schedules alive and that
+    * it holds no more schedules than its limit.
+    *
+    * Must be called after all communication has been checked, since
+    * the new level has no data.
+    *
+    * @returns Whether test passed.
+    */
+   bool
+   verifyScheduleCacheInvalidation();
+
+   /**
+    * Refine data to all levels, with the communication of all levels
+    * aggregated by xfer::ScheduleGroup.
+    */
+   void
+   performGroupedRefineOperations();
+
+   /**
+    * Coarsen data to all levels, with the communication of all levels
+    * aggregated by xfer::ScheduleGroup.
+    */
+   void
+   performGroupedCoarsenOperations();
+
    /**
     * After communication operations are performed, check results.
     *
@@ -356,10 +396,28 @@ private:
 
    bool d_is_reset;
 
+   /*
+    * Whether the refine algorithms cache schedules, and whether a
+    * schedule that should have come from the cache was rebuilt.
+    */
+   bool d_use_schedule_cache;
+   bool d_cache_missed;
+
    std::vector<std::shared_ptr<xfer::RefineSchedule> > d_fill_source_schedule;
    std::vector<std::shared_ptr<xfer::RefineSchedule> > d_refine_schedule;
    std::vector<std::shared_ptr<xfer::CoarsenSchedule> > d_coarsen_schedule;
 
+   /*
+    * Schedule groups, kept across operations so that their aggregated
+    * schedules are reused, and the schedules last added to them.
+    */
+   xfer::ScheduleGroup d_fill_source_group;
+   xfer::ScheduleGroup d_refine_group;
+   xfer::ScheduleGroup d_coarsen_group;
+   std::vector<std::shared_ptr<xfer::RefineSchedule> > d_grouped_fill_source;
+   std::vector<std::shared_ptr<xfer::RefineSchedule> > d_grouped_refine;
+   std::vector<std::shared_ptr<xfer::CoarsenSchedule> > d_grouped_coarsen;
+
 };
 
 }
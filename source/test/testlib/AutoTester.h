@@ -128,6 +128,9 @@ private:
    int d_test_patch_boxes_step_count;
    //!@brief Base name of files used in the run and regression test.
    std::string d_base_name;
+   //!@brief Base name of the file of boxes for regression check,
+   //! which lets a run check against the boxes of another run.
+   std::string d_patch_boxes_base_name;
    //!@brief Whether to write file of boxes for regression check.
    bool d_write_patch_boxes;
    //!@brief Whether to read file of boxes for regression check.